@@ -191,6 +191,12 @@ int main(int argc, char* argv[]) {
 
     // Warmup
     std::cout << "Warming up..." << std::endl;
+    engine->Warmup();
+    for (const auto& bucket : engine->GetWarmupReport()) {
+        std::cout << "  " << std::setw(4) << bucket.token_length << " tokens: cold "
+                  << bucket.cold_latency.count() / 1000.0 << " ms, warm "
+                  << bucket.warm_latency.count() / 1000.0 << " ms" << std::endl;
+    }
     engine->SynthesizeSimple("ウォームアップ", voice_id);
 
     // Run benchmarks
@@ -206,5 +212,18 @@ int main(int argc, char* argv[]) {
     std::cout << "Failed: " << perf_stats.failed_requests << std::endl;
     std::cout << "Average latency: " << perf_stats.average_latency.count() << " ms" << std::endl;
 
+    auto print_percentiles = [](const char* name, const TTSEngine::LatencyPercentiles& p) {
+        std::cout << std::left << std::setw(18) << name
+                  << " p50 " << std::setw(8) << p.p50.count() / 1000.0
+                  << " p90 " << std::setw(8) << p.p90.count() / 1000.0
+                  << " p99 " << std::setw(8) << p.p99.count() / 1000.0
+                  << " p99.9 " << p.p999.count() / 1000.0 << " ms" << std::endl;
+    };
+    print_percentiles("End-to-end", perf_stats.end_to_end);
+    print_percentiles("Phonemization", perf_stats.phonemization);
+    print_percentiles("Tokenization", perf_stats.tokenization);
+    print_percentiles("Inference", perf_stats.inference);
+    print_percentiles("Audio processing", perf_stats.audio_processing);
+
     return 0;
 }
\ No newline at end of file
@@ -324,6 +324,15 @@ JSON Format:
 
             if (j.contains("kokoro_model_path"))
                 config.kokoro_model_path = j["kokoro_model_path"];
+            if (j.contains("kokoro_vocoder_model_path"))
+                config.kokoro_vocoder_model_path = j["kokoro_vocoder_model_path"];
+            if (j.contains("fallback_tiers")) {
+                for (const auto& tier : j["fallback_tiers"]) {
+                    config.fallback_tiers.push_back({tier["name"], tier["model_path"]});
+                }
+            }
+            if (j.contains("tier_step_queue_depth"))
+                config.tier_step_queue_depth = j["tier_step_queue_depth"];
             if (j.contains("dictionary_path"))
                 config.dictionary_path = j["dictionary_path"];
             if (j.contains("voices_dir"))
@@ -512,6 +521,9 @@ JSON Format:
         tts_request.speed = request.value("speed", config_.speed);
         tts_request.pitch = request.value("pitch", config_.pitch);
         tts_request.volume = request.value("volume", config_.volume);
+        if (config_.save_phonemes) {
+            tts_request.diagnostics = Diagnostics::PHONEMES;
+        }
 
         if (request.contains("phonemes")) {
             tts_request.ipa_phonemes = request["phonemes"];
@@ -570,6 +582,9 @@ JSON Format:
         request.pitch = config_.pitch;
         request.volume = config_.volume;
         request.format = config_.format;
+        if (config_.save_phonemes) {
+            request.diagnostics = Diagnostics::PHONEMES;
+        }
 
         if (!config_.phonemes.empty()) {
             request.ipa_phonemes = config_.phonemes;
@@ -614,7 +629,7 @@ JSON Format:
         // Save phonemes if requested
         if (config_.save_phonemes) {
             std::string phoneme_file = output_path.stem().string() + "_phonemes.txt";
-            SavePhonemes(result.phonemes, phoneme_file);
+            SavePhonemes(result.diagnostics.ExpandPhonemes(), phoneme_file);
         }
     }
 
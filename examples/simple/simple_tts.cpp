@@ -53,7 +53,7 @@ void demonstrateBasicTTS(TTSEngine& engine) {
         std::cout << "  Audio duration: " << result.audio.duration.count() << " ms" << std::endl;
         std::cout << "  Audio samples: " << result.audio.samples.size() << std::endl;
         std::cout << "  Processing time: " << result.stats.total_time.count() << " ms" << std::endl;
-        std::cout << "  Phonemes: " << result.phonemes.size() << std::endl;
+        std::cout << "  Phonemes: " << result.stats.phoneme_count << std::endl;
 
         // Save to file
         auto save_status = engine.SaveAudioToFile(result.audio, "simple_output.wav");
@@ -0,0 +1,107 @@
+/**
+ * @file tokenize_tool.cpp
+ * @brief Offline tool that turns text lines into a binary token file
+ * @author D Everett Hinton
+ * @date 2025
+ *
+ * @copyright MIT License
+ */
+
+#include "jp_edge_tts/core/tts_engine.h"
+#include "jp_edge_tts/utils/token_file.h"
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using namespace jp_edge_tts;
+
+/**
+ * @brief Print usage information
+ */
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " <input.txt> <output.jptk>" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Runs each non-empty line of input.txt through the text front-end" << std::endl;
+    std::cout << "(normalization, phonemization, tokenization) and stores the tokens." << std::endl;
+    std::cout << "Record IDs are 1-based line numbers. Pass a record's tokens as" << std::endl;
+    std::cout << "TTSRequest::token_ids to synthesize it without any text processing." << std::endl;
+}
+
+/**
+ * @brief Verify a token file by reading it back and checking the vocabulary
+ */
+bool verifyTokenFile(const std::string& path, size_t expected_records, size_t vocabulary_size) {
+    std::vector<TokenRecord> records;
+    uint32_t stored_vocabulary = 0;
+
+    if (!TokenFile::Read(path, records, &stored_vocabulary)) {
+        std::cerr << "Failed to read back " << path << std::endl;
+        return false;
+    }
+    if (records.size() != expected_records || stored_vocabulary != vocabulary_size) {
+        std::cerr << "Token file " << path << " does not match what was written" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::string input_path = argv[1];
+    std::string output_path = argv[2];
+
+    std::ifstream input(input_path);
+    if (!input) {
+        std::cerr << "Cannot open input file: " << input_path << std::endl;
+        return 1;
+    }
+
+    // Create and configure engine; no audio is produced
+    TTSConfig config;
+    config.enable_cache = false;
+
+    auto engine = CreateTTSEngine(config);
+    if (engine->Initialize() != Status::OK) {
+        std::cerr << "Failed to initialize TTS engine!" << std::endl;
+        std::cerr << "Make sure models and data files are in the correct locations." << std::endl;
+        return 1;
+    }
+
+    std::vector<TokenRecord> records;
+    size_t total_tokens = 0;
+    size_t line_number = 0;
+    std::string line;
+
+    while (std::getline(input, line)) {
+        line_number++;
+        if (line.empty()) {
+            continue;
+        }
+
+        auto [phonemes, tokens] = engine->ProcessText(line);
+        if (tokens.empty()) {
+            std::cerr << "Line " << line_number << ": no tokens produced, skipped" << std::endl;
+            continue;
+        }
+
+        total_tokens += tokens.size();
+        records.push_back(TokenRecord{std::to_string(line_number), std::move(tokens)});
+    }
+
+    size_t vocabulary_size = engine->GetVocabularySize();
+    if (!TokenFile::Write(output_path, records, static_cast<uint32_t>(vocabulary_size))) {
+        std::cerr << "Failed to write token file: " << output_path << std::endl;
+        return 1;
+    }
+    if (!verifyTokenFile(output_path, records.size(), vocabulary_size)) {
+        return 1;
+    }
+
+    std::cout << "Wrote " << records.size() << " records (" << total_tokens
+              << " tokens) to " << output_path << std::endl;
+    return 0;
+}
@@ -94,6 +94,21 @@ public:
     std::vector<float> ApplyFade(const std::vector<float>& samples,
                                  int fade_ms = 50);
 
+    /**
+     * @brief Join segments with overlap-add crossfades
+     *
+     * @details Consecutive segments overlap by crossfade_ms; the tail of
+     * one is faded out with a raised-cosine ramp while the head of the
+     * next is faded in, so the seams stay click-free.
+     *
+     * @param segments Audio segments in playback order
+     * @param crossfade_ms Overlap duration in milliseconds
+     * @return Stitched audio
+     */
+    std::vector<float> ConcatenateWithCrossfade(
+        const std::vector<std::vector<float>>& segments,
+        int crossfade_ms = 10);
+
     /**
      * @brief Resample audio to different sample rate
      *
@@ -0,0 +1,109 @@
+/**
+ * @file inverse_stft.h
+ * @brief Streaming inverse short-time Fourier transform for vocoder output
+ * D Everett Hinton
+ * @date 2025
+ *
+ * @copyright MIT License
+ */
+
+#ifndef JP_EDGE_TTS_INVERSE_STFT_H
+#define JP_EDGE_TTS_INVERSE_STFT_H
+
+#include <cstddef>
+#include <vector>
+
+namespace jp_edge_tts {
+
+/**
+ * @class InverseSTFT
+ * @brief Turns magnitude/phase frames into audio by windowed overlap-add
+ *
+ * @details Matches torch.istft with a periodic Hann window,
+ * win_length = n_fft and center = true: each frame is inverted with a
+ * real inverse DFT, windowed, overlap-added at the hop size and divided
+ * by the summed squared window, and n_fft / 2 samples are dropped at
+ * both ends. N frames give hop * (N - 1) samples.
+ *
+ * The transform sizes used by iSTFT vocoders are tiny (Kokoro uses
+ * n_fft 20, hop 5), so the DFT is a precomputed basis with the window
+ * folded in, applied with contiguous loops the compiler vectorizes.
+ *
+ * Frames may be pushed in pieces; each Push() returns the samples no
+ * later frame can change, so audio can be played while frames are
+ * still being produced.
+ */
+class InverseSTFT {
+public:
+    /**
+     * @brief Constructor
+     * @param n_fft Transform size; frames have n_fft / 2 + 1 bins
+     * @param hop_size Samples between frames
+     */
+    InverseSTFT(size_t n_fft, size_t hop_size);
+
+    /**
+     * @brief Invert a whole spectrogram at once
+     *
+     * @param magnitude Linear magnitudes, bin-major [bins, frames]
+     * @param phase Phases in radians, same layout
+     * @param frames Number of frames
+     * @return hop * (frames - 1) samples
+     */
+    std::vector<float> Transform(const float* magnitude, const float* phase, size_t frames);
+
+    /**
+     * @brief Add frames and collect the samples that are now final
+     *
+     * @param magnitude First frame's magnitude for bin 0; bin k of frame t
+     *                  is at magnitude[k * stride + t]
+     * @param phase Phases, same layout
+     * @param frames Number of frames to add
+     * @param stride Distance between bins (the spectrogram's total frames)
+     * @param out Receives the finished samples
+     */
+    void Push(const float* magnitude, const float* phase,
+              size_t frames, size_t stride, std::vector<float>& out);
+
+    /**
+     * @brief Collect the remaining samples after the last frame
+     * @param out Receives the samples
+     */
+    void Finish(std::vector<float>& out);
+
+    /**
+     * @brief Start a new signal
+     */
+    void Reset();
+
+    size_t GetFFTSize() const { return n_fft; }
+    size_t GetHopSize() const { return hop_size; }
+    size_t GetBinCount() const { return bins; }
+
+private:
+    void Emit(size_t end, std::vector<float>& out);
+
+    size_t n_fft;
+    size_t hop_size;
+    size_t bins;
+
+    // Inverse DFT basis with the synthesis window applied, [bins, n_fft]
+    std::vector<float> cos_basis;
+    std::vector<float> sin_basis;
+    std::vector<float> window_squared;
+
+    // Per-frame scratch
+    std::vector<float> real;
+    std::vector<float> imag;
+    std::vector<float> frame;
+
+    // Overlap-add state; buffer[0] is uncentered sample buffer_start
+    std::vector<float> buffer;
+    std::vector<float> envelope;
+    size_t buffer_start = 0;
+    size_t frames_seen = 0;
+};
+
+} // namespace jp_edge_tts
+
+#endif // JP_EDGE_TTS_INVERSE_STFT_H
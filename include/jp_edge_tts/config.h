@@ -59,8 +59,12 @@ constexpr size_t DEFAULT_MAX_TEXT_LENGTH = 1000;
 // Model Settings
 // ==========================================
 
-constexpr int KOKORO_STYLE_DIM = 128;  // Style vector dimension
+constexpr int KOKORO_STYLE_DIM = 256;  // Style vector dimension (fallback when the model leaves it dynamic)
 constexpr int MAX_TOKEN_LENGTH = 500;   // Maximum token sequence length
+constexpr int KOKORO_SAMPLES_PER_FRAME = 600;  // Output samples per predicted duration frame
+constexpr int KOKORO_PAD_TOKEN = 0;     // Token ID used to pad batched sequences
+constexpr int KOKORO_ISTFT_N_FFT = 20;  // Generator iSTFT size (config.json gen_istft_n_fft)
+constexpr int KOKORO_ISTFT_HOP = 5;     // Generator iSTFT hop (config.json gen_istft_hop_size)
 constexpr int PHONEME_VOCAB_SIZE = 200; // Approximate phoneme vocabulary
 
 // ==========================================
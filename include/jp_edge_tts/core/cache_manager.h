@@ -46,14 +46,19 @@ public:
     /**
      * @brief Get cached result
      *
+     * @details The entry is shared, not copied; it stays valid after
+     * eviction for as long as the caller holds it.
+     *
      * @param key Cache key
-     * @return TTS result if found in cache
+     * @return TTS result if found in cache, otherwise null
      */
-    std::optional<TTSResult> Get(const std::string& key);
+    std::shared_ptr<const TTSResult> Get(const std::string& key);
 
     /**
      * @brief Store result in cache
      *
+     * @details Audio samples are shared with the caller's result.
+     *
      * @param key Cache key
      * @param result TTS result to cache
      */
@@ -110,6 +115,17 @@ public:
      */
     size_t GetCurrentSize() const;
 
+    /**
+     * @brief Evict least recently used entries down to a size
+     *
+     * @details Unlike SetMaxSize() the configured limit is unchanged,
+     * so the cache can grow back once memory is available again.
+     *
+     * @param target_bytes Size to shrink to
+     * @return Bytes freed
+     */
+    size_t TrimTo(size_t target_bytes);
+
     /**
      * @brief Get number of cached entries
      * @return Entry count
@@ -0,0 +1,108 @@
+/**
+ * @file inference_batcher.h
+ * @brief Dynamic micro-batching of concurrent inference calls
+ * D Everett Hinton
+ * @date 2025
+ *
+ * @copyright MIT License
+ */
+
+#ifndef JP_EDGE_TTS_INFERENCE_BATCHER_H
+#define JP_EDGE_TTS_INFERENCE_BATCHER_H
+
+#include "jp_edge_tts/types.h"
+#include <memory>
+#include <vector>
+
+namespace jp_edge_tts {
+
+class CancellationToken;
+
+class SessionManager;
+
+/**
+ * @class InferenceBatcher
+ * @brief Coalesces concurrent inference calls into batches
+ *
+ * @details Calls are grouped into buckets by token length and speed.
+ * Only calls of identical length share a model run (see
+ * SessionManager::RunBatchInference), so buckets wider than one token
+ * only help when several lengths arrive together.
+ * The first caller to arrive in an idle bucket becomes its collector:
+ * it waits until the bucket holds max_batch_size calls or the oldest
+ * call has waited max_wait_ms, then runs the whole group through
+ * SessionManager::RunBatchInference and hands each caller its audio.
+ * Callers whose entries were not taken take over collection in turn,
+ * so no dedicated dispatcher thread is needed.
+ */
+class InferenceBatcher {
+public:
+    /**
+     * @brief Batching statistics
+     */
+    struct BatchStats {
+        size_t total_batches = 0;       ///< Inference calls issued
+        size_t total_items = 0;         ///< Requests served
+        size_t max_observed_batch = 0;  ///< Largest batch issued
+        double average_batch_size = 0;  ///< total_items / total_batches
+    };
+
+    /**
+     * @brief Constructor
+     *
+     * @param session Session used for inference (must outlive the batcher)
+     * @param max_batch_size Maximum rows per inference call
+     * @param max_wait_ms Longest a call waits for company before running
+     * @param bucket_tokens Width of the token-length buckets
+     */
+    InferenceBatcher(SessionManager& session,
+                     size_t max_batch_size,
+                     int max_wait_ms,
+                     size_t bucket_tokens = 1);
+
+    /**
+     * @brief Destructor
+     */
+    ~InferenceBatcher();
+
+    // Disable copy and move
+    InferenceBatcher(const InferenceBatcher&) = delete;
+    InferenceBatcher& operator=(const InferenceBatcher&) = delete;
+    InferenceBatcher(InferenceBatcher&&) = delete;
+    InferenceBatcher& operator=(InferenceBatcher&&) = delete;
+
+    /**
+     * @brief Run inference, possibly batched with concurrent callers
+     *
+     * @details Blocks until this call's audio is ready. Calls with a
+     * non-default pitch bypass batching since the batch path has no
+     * per-row pitch input. A shared batched run is never terminated on
+     * behalf of one caller; cancellation only stops a caller from
+     * joining a batch.
+     *
+     * @param tokens Input token IDs
+     * @param style_vector Voice style embedding
+     * @param speed Speaking speed factor
+     * @param pitch Pitch adjustment factor
+     * @param cancel Cancellation token (may be null)
+     * @return Generated audio samples (empty on failure or cancellation)
+     */
+    std::vector<float> Infer(const std::vector<int>& tokens,
+                             const std::vector<float>& style_vector,
+                             float speed = 1.0f,
+                             float pitch = 1.0f,
+                             CancellationToken* cancel = nullptr);
+
+    /**
+     * @brief Get batching statistics
+     */
+    BatchStats GetStats() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace jp_edge_tts
+
+#endif // JP_EDGE_TTS_INFERENCE_BATCHER_H
@@ -0,0 +1,128 @@
+/**
+ * @file request_scheduler.h
+ * @brief Priority-aware request scheduling for TTS synthesis
+ * D Everett Hinton
+ * @date 2025
+ *
+ * @copyright MIT License
+ */
+
+#ifndef JP_EDGE_TTS_REQUEST_SCHEDULER_H
+#define JP_EDGE_TTS_REQUEST_SCHEDULER_H
+
+#include "jp_edge_tts/types.h"
+#include <memory>
+#include <string>
+#include <functional>
+#include <optional>
+
+namespace jp_edge_tts {
+
+/**
+ * @class RequestScheduler
+ * @brief Per-priority request queues drained by a fixed set of workers
+ *
+ * @details Each Priority level has its own FIFO queue. Workers always
+ * take the oldest request from the highest non-empty level, so CRITICAL
+ * work never waits behind queued LOW work. Queued requests are indexed
+ * by ID, which makes cancellation of not-yet-started work O(1).
+ * An optional queue limit rejects new work immediately once the
+ * backlog is full instead of letting latency grow without bound.
+ */
+class RequestScheduler {
+public:
+    using Task = std::function<void()>;
+
+    /**
+     * @brief Constructor
+     * @param num_workers Number of worker threads (0 = hardware concurrency)
+     * @param max_queue_size Max queued (not running) requests (0 = unbounded)
+     */
+    explicit RequestScheduler(size_t num_workers = 0, size_t max_queue_size = 0);
+
+    /**
+     * @brief Destructor - cancels queued work and joins workers
+     */
+    ~RequestScheduler();
+
+    // Disable copy and move
+    RequestScheduler(const RequestScheduler&) = delete;
+    RequestScheduler& operator=(const RequestScheduler&) = delete;
+    RequestScheduler(RequestScheduler&&) = delete;
+    RequestScheduler& operator=(RequestScheduler&&) = delete;
+
+    /**
+     * @brief Queue a request for execution
+     *
+     * @param request_id Unique request identifier
+     * @param priority Scheduling priority
+     * @param run Work to execute on a worker thread
+     * @param on_cancel Called instead of run if the request is cancelled
+     *                  before it starts (may be null)
+     * @param position_out Receives the queue position before any worker
+     *                     can start run, so run may read it (may be null)
+     * @return Queue position at submission (0 = next to run), or
+     *         std::nullopt if the queue is full
+     */
+    std::optional<size_t> Submit(const std::string& request_id,
+                  Priority priority,
+                  Task run,
+                  Task on_cancel = nullptr,
+                  size_t* position_out = nullptr);
+
+    /**
+     * @brief Cancel a queued request
+     *
+     * @param request_id Request identifier
+     * @return true if the request was still queued and has been removed
+     */
+    bool Cancel(const std::string& request_id);
+
+    /**
+     * @brief Check if a request is queued or running
+     *
+     * @param request_id Request identifier
+     * @return true while the request has not finished
+     */
+    bool IsPending(const std::string& request_id) const;
+
+    /**
+     * @brief Get number of queued (not yet started) requests
+     * @return Queued request count across all priorities
+     */
+    size_t GetQueueSize() const;
+
+    /**
+     * @brief Get number of queued requests at one priority level
+     * @param priority Priority level
+     * @return Queued request count
+     */
+    size_t GetQueueSize(Priority priority) const;
+
+    /**
+     * @brief Get number of requests currently executing
+     * @return Running request count
+     */
+    size_t GetActiveCount() const;
+
+    /**
+     * @brief Get number of worker threads
+     * @return Worker count
+     */
+    size_t GetWorkerCount() const;
+
+    /**
+     * @brief Cancel all queued requests and stop the workers
+     *
+     * @details Requests already running are allowed to finish.
+     */
+    void Shutdown();
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace jp_edge_tts
+
+#endif // JP_EDGE_TTS_REQUEST_SCHEDULER_H
@@ -11,6 +11,8 @@
 #define JP_EDGE_TTS_SESSION_MANAGER_H
 
 #include "jp_edge_tts/types.h"
+#include <chrono>
+#include <functional>
 #include <memory>
 #include <vector>
 #include <string>
@@ -18,12 +20,30 @@
 
 namespace jp_edge_tts {
 
+class CancellationToken;
+
 /**
  * @class SessionManager
  * @brief Manages ONNX Runtime sessions for model inference
  *
  * @details Handles loading ONNX models, creating inference sessions,
  * and running forward passes with proper tensor management.
+ *
+ * The model is loaded into a pool of sessions that share one ONNX
+ * Runtime environment, its arena allocator and a prepacked weights
+ * container. Each inference call checks a session out for its run,
+ * so concurrent callers run in parallel on separate sessions with a
+ * bounded intra-op thread count instead of contending for one.
+ *
+ * The model may also be split in two: an acoustic model (text encoder,
+ * durations and prosody) that ends at frame features, and a vocoder
+ * that turns frame features into audio. The vocoder then runs over
+ * overlapping frame windows, so audio can be delivered before the
+ * whole utterance has been vocoded.
+ *
+ * A model or vocoder exported without the generator's final iSTFT,
+ * ending at outputs named "*mag*" and "*phase*" ([1, bins, frames]),
+ * is finished with the native InverseSTFT instead.
  */
 class SessionManager {
 public:
@@ -73,18 +93,63 @@ public:
      * @param style_vector Voice style embedding
      * @param speed Speaking speed factor
      * @param pitch Pitch adjustment factor
-     * @return Generated audio samples
+     * @param cancel Token that terminates the run when cancelled (may be null)
+     * @return Generated audio samples (empty on failure or cancellation)
      */
     std::vector<float> RunInference(
         const std::vector<int>& tokens,
         const std::vector<float>& style_vector,
         float speed = 1.0f,
-        float pitch = 1.0f
+        float pitch = 1.0f,
+        CancellationToken* cancel = nullptr
+    );
+
+    /**
+     * @brief Receives audio as it is produced
+     *
+     * @param samples Audio for the next stretch of the utterance
+     * @param is_last true for the final stretch
+     */
+    using AudioWindowCallback = std::function<void(std::vector<float> samples, bool is_last)>;
+
+    /**
+     * @brief Run TTS inference, delivering audio one vocoder window at a time
+     *
+     * @details With a split model the acoustic model runs once and the
+     * vocoder then runs window by window, calling on_audio after each.
+     * With a single graph the whole waveform is delivered in one call.
+     * The callback runs on the calling thread while a pooled session is
+     * checked out, so it should hand the audio off rather than block.
+     *
+     * @param tokens Input token IDs
+     * @param style_vector Voice style embedding
+     * @param speed Speaking speed factor
+     * @param pitch Pitch adjustment factor
+     * @param on_audio Receives each window's audio, in order
+     * @param cancel Token that stops the run between windows (may be null)
+     * @return true if all audio was delivered
+     */
+    bool RunStreamingInference(
+        const std::vector<int>& tokens,
+        const std::vector<float>& style_vector,
+        float speed,
+        float pitch,
+        const AudioWindowCallback& on_audio,
+        CancellationToken* cancel = nullptr
     );
 
     /**
      * @brief Run batch inference for multiple inputs
      *
+     * @details When the model accepts a dynamic batch dimension and exposes
+     * predicted durations, inputs of identical token length are stacked
+     * into a single [B, L] tensor and run in one call. Each row of the
+     * output waveform is trimmed to the frames predicted for its tokens.
+     * The export has no length or mask input, so padding shorter rows
+     * would change their durations; inputs of other lengths, and all
+     * inputs for other models, are run one at a time. Loading checks that
+     * stacked rows match single runs and turns batching off if not.
+     *
      * @param batch_tokens Batch of token sequences
      * @param style_vectors Batch of style vectors
      * @param speeds Speed factors for each input
@@ -96,6 +161,24 @@ public:
         const std::vector<float>& speeds
     );
 
+    /**
+     * @brief Check if the loaded model can run multi-row batches
+     * @return true if RunBatchInference uses a single batched call
+     */
+    bool SupportsBatching() const;
+
+    /**
+     * @brief Check if a separate vocoder is loaded (split model)
+     * @return true if RunStreamingInference delivers audio window by window
+     */
+    bool HasVocoder() const;
+
+    /**
+     * @brief Style vector width the model expects
+     * @return The style input's last dimension, or KOKORO_STYLE_DIM if it is dynamic
+     */
+    size_t GetStyleDim() const;
+
     /**
      * @brief Get model input information
      * @return Vector of input tensor names and shapes
@@ -109,11 +192,133 @@ public:
     std::vector<std::pair<std::string, std::vector<int64_t>>> GetOutputInfo() const;
 
     /**
-     * @brief Set number of threads for inference
+     * @brief Sessions in the pool and intra-op threads for each
+     */
+    struct PoolLayout {
+        size_t num_sessions = 1;
+        int threads_per_session = 1;
+    };
+
+    /**
+     * @brief Fill in automatic pool settings from the core count
+     *
+     * @param num_sessions Requested sessions (0 = one per concurrent request,
+     *                     capped at half the cores)
+     * @param threads_per_session Requested intra-op threads (0 = split cores evenly)
+     * @param max_concurrent Expected number of concurrent inference calls
+     * @param cores Available hardware threads
+     * @return Resolved layout
+     */
+    static PoolLayout ResolvePoolLayout(size_t num_sessions, int threads_per_session,
+                                        size_t max_concurrent, unsigned int cores);
+
+    /**
+     * @brief Set intra-op threads per pooled session
      * @param num_threads Number of threads (0 = auto)
+     * @note Takes effect on the next LoadModel()
      */
     void SetNumThreads(int num_threads);
 
+    /**
+     * @brief Set inter-op threads per pooled session
+     * @param num_threads Number of threads (0 = sequential execution)
+     * @note Takes effect on the next LoadModel()
+     */
+    void SetInterOpThreads(int num_threads);
+
+    /**
+     * @brief Let idle ONNX Runtime threads spin before sleeping
+     * @param enable true to spin (ORT default)
+     * @note Takes effect on the next LoadModel()
+     */
+    void SetAllowSpinning(bool enable);
+
+    /**
+     * @brief Set the session pool size
+     *
+     * @param num_sessions Sessions to create (0 = auto)
+     * @param max_concurrent Expected concurrent calls, used by the auto size
+     * @note Takes effect on the next LoadModel()
+     */
+    void SetPoolSize(size_t num_sessions, size_t max_concurrent = 1);
+
+    /**
+     * @brief Get the number of sessions in the loaded pool
+     */
+    size_t GetPoolSize() const;
+
+    /**
+     * @brief Cache the ORT-optimized graph between process starts
+     *
+     * @details On the first LoadModel() the graph optimized with
+     * ORT_ENABLE_ALL is saved in ORT format as
+     * "<stem>.opt-<key>.ort", keyed by model hash, ONNX Runtime version
+     * and CPU features. Later loads open it with optimization disabled.
+     * The model hash is recorded in "<model file>.hash" in the cache
+     * directory and only recomputed when the model's size or
+     * modification time changes. Ignored for GPU sessions and
+     * LoadModelFromMemory().
+     *
+     * @param enable true to read and write the cache
+     * @param directory Cache directory (empty = next to the model)
+     * @note Takes effect on the next LoadModel()
+     */
+    void SetOptimizedModelCache(bool enable, const std::string& directory = "");
+
+    /**
+     * @brief Load a separate vocoder alongside the model
+     *
+     * @details The model passed to LoadModel() must then end at frame
+     * features: every vocoder input must either be named after one of
+     * its outputs, with time as the last axis, or be a [1, D] style
+     * input, which receives the first D values of the voice style. The
+     * vocoder's first output is the waveform. Each pooled session gets
+     * its own vocoder session.
+     *
+     * @param vocoder_path Path to the vocoder ONNX model (empty = single graph)
+     * @note Takes effect on the next LoadModel()
+     */
+    void SetVocoderModel(const std::string& vocoder_path);
+
+    /**
+     * @brief Set how the vocoder is run over frame features
+     *
+     * @param window_frames Frames whose audio each window delivers
+     *                      (0 = the whole utterance at once)
+     * @param context_frames Extra frames vocoded on each side of a window
+     *                       so its edges see real neighbours; their audio
+     *                       is dropped
+     */
+    void SetVocoderWindow(size_t window_frames, size_t context_frames);
+
+    /**
+     * @brief Memory-map model files instead of reading them
+     *
+     * @details LoadModel() maps the model read-only and creates sessions
+     * from the mapped bytes. For ORT format models (the optimized model
+     * cache) initializers are used in place, so processes on one host
+     * share a single page-cache copy of the weights and startup does not
+     * read the whole file. ONNX protobuf models are still parsed into
+     * private memory, but without an extra read buffer.
+     *
+     * @param enable true to map model files
+     * @note Takes effect on the next LoadModel()
+     */
+    void SetMemoryMapping(bool enable);
+
+    /**
+     * @brief How the last LoadModel() went
+     */
+    struct LoadStats {
+        std::chrono::milliseconds load_time{0};     ///< Whole pool, including optimization
+        bool used_optimized_model = false;          ///< Loaded from the optimized cache
+        bool wrote_optimized_model = false;         ///< Optimized and wrote the cache
+        std::chrono::milliseconds time_saved{0};    ///< Net: optimization skipped minus artifact load
+                                                    ///< and hashing time (0 if the cache did not help)
+        std::string optimized_model_path;           ///< Cache file used or written
+    };
+    LoadStats GetLoadStats() const;
+
     /**
      * @brief Enable/disable GPU acceleration
      * @param enable true to use GPU if available
@@ -128,10 +333,22 @@ public:
         double average_latency_ms;
         double min_latency_ms;
         double max_latency_ms;
-        size_t memory_usage_bytes;
+        size_t memory_usage_bytes;  ///< model_bytes + arena_bytes
+        size_t model_bytes;         ///< Serialized weights held by the sessions
+        size_t arena_bytes;         ///< CPU arena bytes held from the system
+        bool arena_measured;        ///< arena_bytes is ORT's figure for the shared arena;
+                                    ///< otherwise the peak tensor bytes since last shrink
     };
     SessionStats GetStats() const;
 
+    /**
+     * @brief Return unused arena memory to the system
+     *
+     * @details ONNX Runtime only shrinks the arena at the end of a run,
+     * so the shrink is applied by the next inference call.
+     */
+    void ShrinkArena();
+
     /**
      * @brief Reset statistics
      */
@@ -139,8 +356,11 @@ public:
 
     /**
      * @brief Warmup the model with dummy input
+     *
+     * @param token_lengths Sequence lengths to run once each
+     * @return false if any warmup run failed
      */
-    void Warmup();
+    bool Warmup(const std::vector<size_t>& token_lengths = {10});
 
 private:
     class Impl;
@@ -0,0 +1,123 @@
+/**
+ * @file thread_tuner.h
+ * @brief Benchmark-driven selection of the ONNX Runtime thread layout
+ * D Everett Hinton
+ * @date 2025
+ *
+ * @copyright MIT License
+ */
+
+#ifndef JP_EDGE_TTS_THREAD_TUNER_H
+#define JP_EDGE_TTS_THREAD_TUNER_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace jp_edge_tts {
+
+/**
+ * @brief One thread layout and how it performed on this host
+ */
+struct ThreadProfile {
+    // Layout
+    size_t session_pool_size = 1;    ///< Sessions in the pool
+    int intra_threads = 1;           ///< Intra-op threads per session
+    int inter_threads = 0;           ///< Inter-op threads (0 = sequential execution)
+    bool allow_spinning = true;      ///< Let idle ORT threads spin
+
+    // Measurement
+    double throughput = 0;           ///< Inferences per second over the length mix
+    double p95_ms = 0;               ///< 95th percentile inference latency
+
+    // Where it was measured; a profile is only reused on the same host and model
+    std::string host;
+    unsigned int cores = 0;
+    std::string model_path;
+    int64_t model_size = 0;
+};
+
+/**
+ * @class ThreadTuner
+ * @brief Sweeps thread layouts on the real model and keeps the best
+ *
+ * @details Each candidate varies the session pool width, intra-op
+ * threads, sequential vs. parallel execution and thread spinning. A
+ * candidate gets its own SessionManager, is warmed up, then driven by
+ * one closed-loop client per pooled session for a fixed time over a mix
+ * of token lengths. The winner has the highest throughput among the
+ * candidates whose p95 latency meets the target; if none does, the one
+ * with the lowest p95 wins.
+ */
+class ThreadTuner {
+public:
+    /**
+     * @brief Tuning inputs
+     */
+    struct Options {
+        std::string model_path;
+        std::vector<int> token_pattern;             ///< Real token IDs, repeated to each length
+        std::vector<float> style_vector;            ///< Voice style to run with (empty = neutral)
+        std::vector<size_t> token_lengths = {16, 50, 150, 400};
+        double target_p95_ms = 0;                   ///< Latency bound (0 = none)
+        std::chrono::milliseconds run_time{2000};   ///< Measurement time per candidate
+
+        // Model loading, as the engine will load it
+        bool cache_optimized_model = true;
+        std::string optimized_model_dir;
+        bool mmap_model = false;
+        std::string vocoder_model_path;             ///< Split model vocoder (empty = single graph)
+
+        bool verbose = false;
+    };
+
+    explicit ThreadTuner(Options options);
+
+    /**
+     * @brief Measure every candidate and return the best layout
+     * @return Winning profile (session_pool_size 0 if nothing could run)
+     */
+    ThreadProfile Tune();
+
+    /**
+     * @brief Layouts worth trying on a host with this many cores
+     */
+    static std::vector<ThreadProfile> Candidates(unsigned int cores);
+
+    /**
+     * @brief Pick the winner from measured candidates
+     *
+     * @param measured Candidates with throughput and p95 filled in
+     * @param target_p95_ms Latency bound (0 = none)
+     * @return Index of the winner, or -1 if measured is empty
+     */
+    static int SelectBest(const std::vector<ThreadProfile>& measured, double target_p95_ms);
+
+    /**
+     * @brief Default per-host profile location, next to the model
+     */
+    static std::string DefaultProfilePath(const std::string& model_path);
+
+    /**
+     * @brief Name of this host
+     */
+    static std::string HostName();
+
+    /**
+     * @brief Check that a profile was measured on this host for this model
+     */
+    static bool Matches(const ThreadProfile& profile, const std::string& model_path);
+
+    static bool LoadProfile(const std::string& path, ThreadProfile& profile);
+    static bool SaveProfile(const std::string& path, const ThreadProfile& profile);
+
+private:
+    bool Measure(ThreadProfile& candidate) const;
+
+    Options options;
+};
+
+} // namespace jp_edge_tts
+
+#endif // JP_EDGE_TTS_THREAD_TUNER_H
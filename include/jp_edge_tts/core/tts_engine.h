@@ -103,11 +103,29 @@ public:
     // Check if engine is initialized and ready
     bool IsInitialized() const;
 
-    // Update configuration (some settings require re-initialization)
+    // Update configuration; on an initialized engine this is a blocking ReloadAsync()
     Status UpdateConfig(const TTSConfig& config);
 
-    // Get current configuration
-    const TTSConfig& GetConfig() const;
+    /**
+     * @brief Reload model, voices and dictionary without stopping synthesis
+     *
+     * @details Components whose settings changed are built and warmed
+     * in the background while requests keep running on the current
+     * ones. The new set is then swapped in atomically; requests already
+     * running finish on the components they started with. Cached audio
+     * from the old set is never served after the swap. If loading fails
+     * the current components stay in place.
+     *
+     * @param config New configuration
+     * @return Future resolving to the reload status
+     *
+     * @note Scheduler, pipeline and cache sizing and the output sample
+     *       rate keep their Initialize() values
+     */
+    std::future<Status> ReloadAsync(const TTSConfig& config);
+
+    // Get current configuration (a copy; a reload may replace it at any time)
+    TTSConfig GetConfig() const;
 
     // ==========================================
     // Voice Management
@@ -157,28 +175,76 @@ public:
     // Full synthesis with all options
     TTSResult Synthesize(const TTSRequest& request);
 
-    // Batch synthesis for multiple texts
+    /**
+     * @brief Synthesize many requests for maximum throughput
+     *
+     * @details Identical cacheable requests run once and cache hits are
+     * answered immediately. The rest run longest-first across the worker
+     * pool. Request priority and the queue limit do not apply.
+     *
+     * @param requests Requests to synthesize
+     * @return Results in input order
+     */
     std::vector<TTSResult> SynthesizeBatch(const std::vector<TTSRequest>& requests);
 
+    /**
+     * @brief Streaming synthesis with per-sentence audio delivery
+     *
+     * @param request Synthesis request
+     * @param on_chunk Called with each audio chunk as soon as it is ready
+     * @return TTSResult with the concatenated audio and aggregated stats
+     *
+     * @details The text is split at sentence and clause punctuation and
+     * segments are synthesized in order. Each segment's audio is handed
+     * to on_chunk on the calling thread before the next segment starts,
+     * so time-to-first-audio depends on the first sentence only. With a
+     * split acoustic/vocoder model (TTSConfig::kokoro_vocoder_model_path)
+     * each sentence is delivered in vocoder windows, so time-to-first-audio
+     * only covers the acoustic model and the first window. Chunk indices
+     * count delivered chunks across all segments.
+     *
+     * @example
+     * @code
+     * engine->SynthesizeStream(request, [&](const AudioData& chunk, size_t, bool) {
+     *     player.Enqueue(chunk.samples);
+     * });
+     * @endcode
+     */
+    TTSResult SynthesizeStream(const TTSRequest& request, AudioChunkCallback on_chunk);
+
     // ==========================================
     // Asynchronous TTS Synthesis
     // ==========================================
 
-    // Async synthesis returning a future
+    // Async synthesis returning a future; fails fast with ERROR_QUEUE_FULL
+    // or ERROR_TIMEOUT under overload
     std::future<TTSResult> SynthesizeAsync(const TTSRequest& request);
 
-    // Batch async synthesis
+    // Batch async synthesis; same execution as SynthesizeBatch, one future
+    // per request in input order
     std::vector<std::future<TTSResult>> SynthesizeBatchAsync(
         const std::vector<TTSRequest>& requests);
 
-    // Submit request to queue (fire-and-forget)
+    /**
+     * @brief Submit request to queue (fire-and-forget)
+     *
+     * @param request Synthesis request; its priority selects the queue
+     * @param callback Receives the audio on success
+     * @return Request ID, or empty string if the engine is not initialized
+     *
+     * @details Requests are served strictly by priority, oldest first
+     * within a level. Failures are reported through the error callback,
+     * including ERROR_QUEUE_FULL when the queue is at max_queue_size and
+     * ERROR_TIMEOUT when the request's deadline cannot be met.
+     */
     std::string SubmitRequest(const TTSRequest& request,
                              AudioCallback callback = nullptr);
 
-    // Check request status
+    // Check request status (true once finished, cancelled or unknown)
     bool IsRequestComplete(const std::string& request_id) const;
 
-    // Cancel a pending request
+    // Cancel a request: queued requests are dropped (O(1)); running ones
+    // stop at the next stage or chunk and abort any inference in progress
     bool CancelRequest(const std::string& request_id);
 
     // ==========================================
@@ -201,6 +267,12 @@ public:
     // Convert IPA phonemes to token IDs
     std::vector<int> PhonemesToTokens(const std::string& phonemes);
 
+    // Expand token IDs (e.g. ResultDiagnostics::token_ids) for debugging
+    std::vector<TokenInfo> DescribeTokens(const std::vector<int>& tokens) const;
+
+    // Size of the loaded tokenizer vocabulary (stored in token files)
+    size_t GetVocabularySize() const;
+
     // Full pipeline: text -> phonemes -> tokens (for debugging)
     std::pair<std::string, std::vector<int>> ProcessText(const std::string& text);
 
@@ -243,6 +315,8 @@ public:
         size_t hit_count;
         size_t miss_count;
         float hit_rate;
+        size_t inflight_leader_count;  // Requests that ran synthesis
+        size_t inflight_attach_count;  // Requests that joined an identical one in flight
     };
     CacheStats GetCacheStats() const;
 
@@ -259,13 +333,34 @@ public:
     // Get number of active synthesis operations
     size_t GetActiveSynthesisCount() const;
 
+    // Get per-stage pipeline statistics (empty unless enable_pipeline)
+    struct StageStats {
+        std::string name;
+        size_t workers;
+        size_t queue_depth;
+        size_t peak_queue_depth;
+        size_t queue_capacity;
+        size_t processed;
+        std::chrono::milliseconds busy_time;
+    };
+    std::vector<StageStats> GetPipelineStats() const;
+
     // Set progress callback for long operations
     void SetProgressCallback(ProgressCallback callback);
 
     // Set error callback
     void SetErrorCallback(ErrorCallback callback);
 
-    // Get performance statistics
+    // Latency percentiles for one stage (microsecond resolution)
+    struct LatencyPercentiles {
+        size_t count;
+        std::chrono::microseconds p50;
+        std::chrono::microseconds p90;
+        std::chrono::microseconds p99;
+        std::chrono::microseconds p999;
+    };
+
+    // Get performance statistics; latencies cover successful requests
     struct PerformanceStats {
         size_t total_requests;
         size_t successful_requests;
@@ -274,12 +369,29 @@ public:
         std::chrono::milliseconds min_latency;
         std::chrono::milliseconds max_latency;
         float requests_per_second;
+
+        LatencyPercentiles end_to_end;
+        LatencyPercentiles phonemization;
+        LatencyPercentiles tokenization;
+        LatencyPercentiles inference;
+        LatencyPercentiles audio_processing;
     };
     PerformanceStats GetPerformanceStats() const;
 
     // Reset performance counters
     void ResetPerformanceStats();
 
+    /**
+     * @brief Write buffered stage spans as Chrome trace-event JSON
+     *
+     * @param path Output file (open in chrome://tracing or Perfetto)
+     * @return OK on success, ERROR_FILE_NOT_FOUND if it cannot be written
+     *
+     * @details Spans are only recorded in builds configured with
+     * ENABLE_PROFILING; otherwise the trace contains no events.
+     */
+    Status DumpTrace(const std::string& path) const;
+
     // ==========================================
     // Advanced Features
     // ==========================================
@@ -299,20 +411,68 @@ public:
     // Export current dictionary
     Status ExportDictionary(const std::string& output_path);
 
-    // Warmup the engine with dummy inference
+    /**
+     * @brief Warmup the engine with dummy inference
+     *
+     * @details Sweeps representative token lengths (16, 50, 150, 400,
+     * capped at max_chunk_tokens). Each length runs once cold, then once
+     * per loaded voice and at least once per worker thread concurrently,
+     * so arenas and kernels are ready for every shape a request can hit.
+     *
+     * @return OK, or ERROR_INFERENCE_FAILED if a warmup inference failed
+     */
     Status Warmup();
 
+    // Per-length timings from the last Warmup()
+    struct WarmupStats {
+        size_t token_length;
+        std::chrono::microseconds cold_latency;  // First inference at this length
+        std::chrono::microseconds warm_latency;  // Median of the concurrent runs
+        size_t warm_runs;
+    };
+    std::vector<WarmupStats> GetWarmupReport() const;
+
+    // Model load timing from the last Initialize() or reload
+    struct StartupStats {
+        std::chrono::milliseconds model_load_time{0};  // All pooled sessions
+        bool optimized_model_cached = false;           // Loaded the pre-optimized graph
+        std::chrono::milliseconds time_saved{0};       // Net of artifact load and hashing; 0 if no gain
+        std::string optimized_model_path;              // Empty if the cache is off
+    };
+    StartupStats GetStartupReport() const;
+
     // ==========================================
     // Resource Management
     // ==========================================
 
+    // Memory held by each component
+    struct MemoryUsage {
+        size_t session_bytes;     // Model weights and inference arena
+        size_t cache_bytes;       // Cached synthesis results
+        size_t dictionary_bytes;  // Phoneme dictionary
+        size_t voice_bytes;       // Resident voice style vectors
+        size_t queued_bytes;      // Requests waiting to be scheduled
+        size_t total_bytes;
+        size_t budget_bytes;      // 0 = unlimited
+    };
+    MemoryUsage GetMemoryBreakdown() const;
+
     // Get memory usage in bytes
     size_t GetMemoryUsage() const;
 
-    // Release unused resources
+    // Drop expired cache entries, idle voices and unused arena memory
     void ReleaseUnusedResources();
 
-    // Set memory limits
+    /**
+     * @brief Set an engine-wide memory budget
+     *
+     * @details While usage is over budget memory is shed in order:
+     * cached results (least recently used first), then voices idle for
+     * a minute, then the inference arena. The check runs after results
+     * are cached, voices are loaded and requests are queued.
+     *
+     * @param max_bytes Budget in bytes (0 = unlimited)
+     */
     void SetMaxMemoryUsage(size_t max_bytes);
 
     // Shutdown the engine gracefully
@@ -11,6 +11,7 @@
 #define JP_EDGE_TTS_VOICE_MANAGER_H
 
 #include "jp_edge_tts/types.h"
+#include <chrono>
 #include <memory>
 #include <vector>
 #include <string>
@@ -137,6 +138,19 @@ public:
      */
     size_t GetMemoryUsage() const;
 
+    /**
+     * @brief Free voices that have not been used recently
+     *
+     * @details Only voices loaded from a file are released, and never
+     * the default voice. A released voice still counts for HasVoice()
+     * and GetVoiceIds() and is re-read from its file by the next
+     * GetVoice() call. GetAllVoices() lists resident voices only.
+     *
+     * @param idle_for Release voices unused for at least this long
+     * @return Bytes freed
+     */
+    size_t ReleaseIdleVoices(std::chrono::seconds idle_for);
+
     /**
      * @brief Export voice to JSON file
      *
@@ -71,6 +71,8 @@ typedef enum {
     JP_TTS_ERROR_UNSUPPORTED = 6,     ///< Unsupported operation
     JP_TTS_ERROR_NOT_INITIALIZED = 7,  ///< Engine not initialized
     JP_TTS_ERROR_TIMEOUT = 8,         ///< Operation timed out
+    JP_TTS_ERROR_CANCELLED = 9,       ///< Request was cancelled
+    JP_TTS_ERROR_QUEUE_FULL = 10,     ///< Request rejected, queue full
     JP_TTS_ERROR_UNKNOWN = -1         ///< Unknown error
 } jp_tts_status_t;
 
@@ -84,6 +86,15 @@ typedef enum {
     JP_TTS_FORMAT_RAW_FLOAT32 = 3     ///< Raw 32-bit float
 } jp_tts_audio_format_t;
 
+/**
+ * @brief Diagnostics flags for jp_tts_request_t::diagnostics (combine with |)
+ */
+typedef enum {
+    JP_TTS_DIAGNOSTICS_NONE = 0,      ///< Audio only (default)
+    JP_TTS_DIAGNOSTICS_PHONEMES = 1,  ///< Keep phonemes for jp_tts_result_get_phonemes()
+    JP_TTS_DIAGNOSTICS_TOKENS = 2     ///< Keep the model token sequence
+} jp_tts_diagnostics_t;
+
 /**
  * @brief TTS configuration structure
  */
@@ -95,6 +106,7 @@ typedef struct {
     const char* voices_dir;            ///< Directory containing voice files
 
     int32_t max_concurrent_requests;   ///< Max parallel synthesis (default: 4)
+    int32_t max_queue_size;            ///< Max queued requests (< 0 = default of 100, 0 = unbounded)
     int32_t onnx_inter_threads;        ///< ONNX inter-op threads (0 = auto)
     int32_t onnx_intra_threads;        ///< ONNX intra-op threads (0 = auto)
     bool enable_gpu;                   ///< Enable GPU acceleration
@@ -124,15 +136,20 @@ typedef struct {
     jp_tts_audio_format_t format;     ///< Output audio format
 
     const char* ipa_phonemes;          ///< Optional: pre-computed IPA phonemes
+    const int32_t* token_ids;          ///< Optional: pre-computed model tokens (skips text processing)
+    size_t token_count;                ///< Number of entries in token_ids
     int32_t vocabulary_id;             ///< Optional: vocabulary ID (-1 = none)
     bool use_cache;                    ///< Use caching
+    int32_t timeout_ms;                ///< Optional: deadline from submission (0 = none)
+    uint32_t diagnostics;              ///< jp_tts_diagnostics_t flags (0 = none)
 } jp_tts_request_t;
 
 /**
  * @brief Audio data information
  */
 typedef struct {
-    float* samples;                    ///< Audio samples (normalized -1 to 1)
+    const float* samples;              ///< Audio samples (normalized -1 to 1); owned by the result
+                                       ///< and valid until jp_tts_result_free()
     size_t sample_count;               ///< Number of samples
     int32_t sample_rate;               ///< Sample rate in Hz
     int32_t channels;                  ///< Number of channels
@@ -332,9 +349,12 @@ jp_tts_result_get_wav_bytes(jp_tts_result_t result, uint8_t* buffer,
 /**
  * @brief Get phonemes from result
  *
+ * @details Only available when the request set JP_TTS_DIAGNOSTICS_PHONEMES;
+ * otherwise an empty string is returned.
+ *
  * @param result Result handle
  * @param buffer Output buffer for phonemes (NULL to query size)
- * @param buffer_size In: buffer size, Out: string length
+ * @param buffer_size In: buffer size, Out: string length including the terminator
  * @return Status code
  */
 JP_EDGE_TTS_API jp_tts_status_t JP_EDGE_TTS_CALL
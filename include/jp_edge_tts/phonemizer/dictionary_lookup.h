@@ -53,6 +53,12 @@ public:
      */
     size_t Size() const;
 
+    /**
+     * @brief Get approximate memory held by entries
+     * @return Memory usage in bytes
+     */
+    size_t GetMemoryUsage() const;
+
     /**
      * @brief Clear dictionary
      */
@@ -259,6 +259,14 @@ public:
      */
     Status Warmup();
 
+    /**
+     * @brief Get approximate memory held by the dictionary
+     *
+     * @return Memory usage in bytes
+     * @note Walks every entry; callers should not poll it per request
+     */
+    size_t GetMemoryUsage() const;
+
 private:
     /**
      * @brief Private implementation
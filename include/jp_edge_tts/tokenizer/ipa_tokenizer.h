@@ -13,6 +13,7 @@
 #include <string>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include <memory>
 
 namespace jp_edge_tts {
@@ -149,6 +150,21 @@ public:
     std::vector<int> TruncateTokens(const std::vector<int>& tokens,
                                     size_t max_length);
 
+    /**
+     * @brief Split a token sequence into chunks at prosodic boundaries
+     *
+     * @details Cuts after sentence-final punctuation (. ! ? …) where
+     * possible, then after clause punctuation (, ; : —), then after a
+     * word space, and only hard-cuts when a run has no boundary at all.
+     * Boundary IDs are taken from the loaded vocabulary.
+     *
+     * @param tokens Input tokens
+     * @param max_tokens Maximum tokens per chunk
+     * @return Chunks in order; a single chunk if already within budget
+     */
+    std::vector<std::vector<int>> ChunkTokens(const std::vector<int>& tokens,
+                                              size_t max_tokens) const;
+
 private:
     class Impl;
     std::unique_ptr<Impl> pImpl;
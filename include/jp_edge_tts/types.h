@@ -1,6 +1,7 @@
 #ifndef JP_EDGE_TTS_TYPES_H
 #define JP_EDGE_TTS_TYPES_H
 
+#include "jp_edge_tts/config.h"
 #include <string>
 #include <vector>
 #include <memory>
@@ -11,6 +12,8 @@
 
 namespace jp_edge_tts {
 
+class CancellationToken;
+
 // ==========================================
 // Enumerations
 // ==========================================
@@ -27,6 +30,8 @@ enum class Status {
     ERROR_CACHE_MISS,
     ERROR_TIMEOUT,
     ERROR_NOT_INITIALIZED,
+    ERROR_CANCELLED,
+    ERROR_QUEUE_FULL,
     ERROR_UNKNOWN
 };
 
@@ -53,6 +58,29 @@ enum class Priority {
     CRITICAL = 3
 };
 
+// Which model tier may serve a request (see TTSConfig::fallback_tiers)
+enum class QualityHint {
+    AUTO,       // Primary model; faster tiers under load or a tight deadline
+    HIGHEST,    // Always the primary model
+    FASTEST     // Always the fastest tier
+};
+
+// Optional per-request diagnostics returned with the result (bit flags)
+enum class Diagnostics : uint32_t {
+    NONE = 0,
+    PHONEMES = 1 << 0,    // Phoneme breakdown of the input
+    TOKENS = 1 << 1,      // Model token sequence
+    ALL = PHONEMES | TOKENS
+};
+
+inline Diagnostics operator|(Diagnostics a, Diagnostics b) {
+    return static_cast<Diagnostics>(static_cast<uint32_t>(a) | static_cast<uint32_t>(b));
+}
+
+inline bool HasDiagnostics(Diagnostics set, Diagnostics flag) {
+    return (static_cast<uint32_t>(set) & static_cast<uint32_t>(flag)) != 0;
+}
+
 // ==========================================
 // Core Data Structures
 // ==========================================
@@ -81,17 +109,60 @@ struct TTSRequest {
     float volume = 1.0f;                         // Volume adjustment (0.0-1.0)
     AudioFormat format = AudioFormat::WAV_PCM16; // Output format
     Priority priority = Priority::NORMAL;        // Processing priority
+    QualityHint quality = QualityHint::AUTO;     // Model tier preference
 
     // Advanced options
     std::optional<std::string> ipa_phonemes;     // Pre-computed IPA phonemes
+    std::optional<std::vector<int>> token_ids;   // Pre-computed model tokens; skips the text front-end
     std::optional<int> vocabulary_id;            // Pre-defined vocabulary ID
     bool use_cache = true;                       // Enable caching
     bool normalize_text = true;                  // Normalize input text
+    Diagnostics diagnostics = Diagnostics::NONE; // Debug data to return in TTSResult
+
+    // Latest time the result is still useful; requests that cannot finish
+    // in time fail with ERROR_TIMEOUT instead of running inference
+    std::optional<std::chrono::steady_clock::time_point> deadline;
+
+    // Cancelling this token stops the request between stages and chunks
+    // and terminates a running inference (see utils/cancellation_token.h)
+    std::shared_ptr<CancellationToken> cancellation;
+};
+
+// Immutable, reference-counted audio samples. Copies share one
+// allocation, so cached results are handed out without copying audio.
+// Converts implicitly to const std::vector<float>& for read-only APIs.
+class SampleBuffer {
+public:
+    SampleBuffer() = default;
+
+    // Takes ownership of the samples without copying them
+    SampleBuffer(std::vector<float> samples)
+        : storage(samples.empty() ? nullptr :
+                  std::make_shared<const std::vector<float>>(std::move(samples))) {}
+
+    size_t size() const { return storage ? storage->size() : 0; }
+    bool empty() const { return size() == 0; }
+    const float* data() const { return storage ? storage->data() : nullptr; }
+    const float* begin() const { return data(); }
+    const float* end() const { return data() + size(); }
+    float operator[](size_t index) const { return (*storage)[index]; }
+
+    const std::vector<float>& vector() const {
+        static const std::vector<float> no_samples;
+        return storage ? *storage : no_samples;
+    }
+    operator const std::vector<float>&() const { return vector(); }
+
+    // Number of buffers sharing this allocation (0 when empty)
+    long use_count() const { return storage.use_count(); }
+
+private:
+    std::shared_ptr<const std::vector<float>> storage;
 };
 
 // Audio data container
 struct AudioData {
-    std::vector<float> samples;                  // Audio samples (normalized -1 to 1)
+    SampleBuffer samples;                        // Audio samples (normalized -1 to 1), shared
     int sample_rate = 24000;                     // Sample rate (Hz)
     int channels = 1;                            // Number of channels (mono)
     std::chrono::milliseconds duration{0};       // Audio duration
@@ -131,6 +202,72 @@ struct TokenInfo {
     int position;                                // Position in sequence
 };
 
+// Diagnostics kept in compact form: the phoneme string with an offset
+// table and the raw token IDs. Per-phoneme strings are only built when
+// ExpandPhonemes() is called (see TTSEngine::DescribeTokens for tokens).
+struct ResultDiagnostics {
+    std::string phoneme_text;                    // Space-separated IPA phonemes
+    std::vector<uint32_t> phoneme_offsets;       // Start of each phoneme in phoneme_text
+    std::vector<int> token_ids;                  // Model token sequence
+
+    size_t PhonemeCount() const { return phoneme_offsets.size(); }
+
+    // Index space-separated phonemes; returns the count. Offsets are
+    // only recorded when a table is passed.
+    static size_t IndexPhonemes(const std::string& text, std::vector<uint32_t>* offsets) {
+        size_t count = 0;
+        size_t begin = text.find_first_not_of(' ');
+        while (begin != std::string::npos) {
+            if (offsets) {
+                offsets->push_back(static_cast<uint32_t>(begin));
+            }
+            count++;
+            begin = text.find_first_not_of(' ', text.find(' ', begin));
+        }
+        return count;
+    }
+
+    void SetPhonemes(std::string text) {
+        phoneme_text = std::move(text);
+        phoneme_offsets.clear();
+        IndexPhonemes(phoneme_text, &phoneme_offsets);
+    }
+
+    // Append another segment's diagnostics (streaming aggregation)
+    void Append(const ResultDiagnostics& other) {
+        uint32_t shift = static_cast<uint32_t>(phoneme_text.size());
+        if (!other.phoneme_offsets.empty() && !phoneme_text.empty()) {
+            phoneme_text += ' ';
+            shift++;
+        }
+        phoneme_text += other.phoneme_text;
+        for (uint32_t offset : other.phoneme_offsets) {
+            phoneme_offsets.push_back(offset + shift);
+        }
+        token_ids.insert(token_ids.end(), other.token_ids.begin(), other.token_ids.end());
+    }
+
+    std::string Phoneme(size_t index) const {
+        size_t begin = phoneme_offsets[index];
+        return phoneme_text.substr(begin, phoneme_text.find(' ', begin) - begin);
+    }
+
+    std::vector<PhonemeInfo> ExpandPhonemes() const {
+        std::vector<PhonemeInfo> phonemes(phoneme_offsets.size());
+        for (size_t i = 0; i < phonemes.size(); i++) {
+            phonemes[i].phoneme = Phoneme(i);
+            phonemes[i].position = static_cast<int>(i);
+        }
+        return phonemes;
+    }
+
+    size_t GetMemorySize() const {
+        return phoneme_text.capacity() +
+               phoneme_offsets.capacity() * sizeof(uint32_t) +
+               token_ids.capacity() * sizeof(int);
+    }
+};
+
 // Processing statistics
 struct ProcessingStats {
     std::chrono::milliseconds total_time{0};     // Total processing time
@@ -138,22 +275,24 @@ struct ProcessingStats {
     std::chrono::milliseconds tokenization_time{0};  // Time for tokenization
     std::chrono::milliseconds inference_time{0};     // ONNX inference time
     std::chrono::milliseconds audio_processing_time{0}; // Audio post-processing
+    std::chrono::milliseconds first_chunk_time{0};   // Time to first streamed chunk
 
     size_t text_length = 0;                      // Input text length
     size_t phoneme_count = 0;                    // Number of phonemes
     size_t token_count = 0;                      // Number of tokens
     size_t audio_samples = 0;                    // Number of audio samples
+    size_t chunk_count = 0;                      // Number of streamed chunks
 
     bool cache_hit = false;                      // Whether cache was used
     int queue_position = 0;                      // Position in processing queue
+    std::string model_tier;                      // Model tier that ran inference (empty if none ran)
 };
 
 // TTS result with metadata
 struct TTSResult {
     Status status = Status::OK;                  // Operation status
     AudioData audio;                             // Generated audio data
-    std::vector<PhonemeInfo> phonemes;           // Phoneme breakdown
-    std::vector<TokenInfo> tokens;               // Token sequence (for debugging)
+    ResultDiagnostics diagnostics;               // Filled per TTSRequest::diagnostics
     ProcessingStats stats;                       // Performance statistics
     std::string error_message;                   // Error description if failed
 
@@ -178,20 +317,55 @@ struct CacheEntry {
     }
 };
 
+// A faster variant of the primary model (e.g. a reduced or pruned export).
+// It must take the same tokens and voices and produce the same output.
+struct ModelTierConfig {
+    std::string name;                            // Reported in ProcessingStats::model_tier
+    std::string model_path;                      // ONNX model
+};
+
 // Configuration for TTS engine
 struct TTSConfig {
     // Model paths
     std::string kokoro_model_path = "models/kokoro-v1.0.int8.onnx";
+    std::string kokoro_vocoder_model_path;       // Split model: vocoder stage (empty = single graph)
     std::string phonemizer_model_path = "models/phonemizer.onnx";
     std::string dictionary_path = "data/ja_phonemes.json";
     std::string tokenizer_vocab_path = "models/tokenizer_vocab.json";
     std::string voices_dir = "models/voices";
 
+    // Model tiers; kokoro_model_path is the primary (highest quality) tier
+    std::string model_tier_name = "default";     // Name of the primary tier
+    std::vector<ModelTierConfig> fallback_tiers; // Faster variants, in decreasing quality
+    size_t tier_step_queue_depth = 4;            // Queued requests per step down a tier (0 = off)
+
     // Performance settings
     int max_concurrent_requests = 4;             // Max parallel synthesis
-    int onnx_inter_threads = 0;                  // 0 = auto (all cores)
-    int onnx_intra_threads = 0;                  // 0 = auto
+    size_t max_queue_size = DEFAULT_QUEUE_SIZE;  // Max queued async requests (0 = unbounded)
+    size_t max_memory_mb = 0;                    // Engine-wide memory budget (0 = unlimited)
+    size_t onnx_session_pool_size = 0;           // Sessions sharing the model (0 = auto from cores)
+    int onnx_intra_threads = 0;                  // Intra-op threads per session (0 = split cores)
+    int onnx_inter_threads = 0;                  // Inter-op threads per session (0 = sequential)
+    bool onnx_allow_spinning = true;             // Idle ORT threads spin (lower latency, more CPU)
+    bool auto_tune_threads = false;              // Benchmark thread layouts when no host profile exists
+    double auto_tune_target_p95_ms = 0;          // Latency bound for auto-tuning (0 = none)
+    std::string thread_profile_path;             // Per-host thread profile (empty = next to the model)
+    bool cache_optimized_model = true;           // Reuse the ORT-optimized graph (not always faster; see StartupStats)
+    std::string optimized_model_dir;             // Where it is kept (empty = next to the model)
+    bool mmap_model = false;                     // Map the model file; shares weights across processes
     bool enable_gpu = false;                     // Use GPU if available
+    size_t max_chunk_tokens = MAX_TOKEN_LENGTH;  // Token budget per inference call
+    int chunk_crossfade_ms = 10;                 // Crossfade between stitched chunks
+    size_t max_batch_size = 1;                   // Max requests per inference call (1 = no batching)
+    int max_batch_wait_ms = 5;                   // Max time a request waits to be batched
+    size_t batch_bucket_tokens = 1;              // Token-length bucket width (rows only batch at equal length)
+
+    // Pipeline settings
+    bool enable_pipeline = false;                // Run stages on dedicated workers
+    int pipeline_frontend_workers = 1;           // Normalize/phonemize/tokenize workers
+    int pipeline_inference_workers = 1;          // ONNX inference workers
+    int pipeline_postprocess_workers = 1;        // Audio post-processing workers
+    size_t pipeline_queue_depth = 16;            // Capacity of each stage queue
 
     // Cache settings
     bool enable_cache = true;                    // Enable result caching
@@ -209,6 +383,11 @@ struct TTSConfig {
     bool normalize_numbers = true;               // Convert numbers to words
     bool expand_abbreviations = true;            // Expand common abbreviations
 
+    // Streaming settings
+    size_t stream_min_clause_chars = 8;          // Min chars before splitting at a clause
+    size_t vocoder_window_frames = 32;           // Frames per streamed vocoder window (0 = whole segment)
+    size_t vocoder_context_frames = 8;           // Extra frames vocoded on each side of a window
+
     // Debug settings
     bool verbose = false;                        // Enable verbose logging
     bool save_intermediate = false;              // Save intermediate results
@@ -219,6 +398,9 @@ struct TTSConfig {
 using ProgressCallback = std::function<void(float progress, const std::string& stage)>;
 using ErrorCallback = std::function<void(Status status, const std::string& message)>;
 using AudioCallback = std::function<void(const AudioData& audio)>;
+using AudioChunkCallback = std::function<void(const AudioData& chunk,
+                                              size_t chunk_index,
+                                              bool is_final)>;
 
 } // namespace jp_edge_tts
 
@@ -0,0 +1,151 @@
+/**
+ * @file bounded_queue.h
+ * @brief Blocking fixed-capacity queue for pipeline stages
+ * @author JP Edge TTS Project
+ * @date 2024
+ *
+ * @copyright MIT License
+ */
+
+#ifndef JP_EDGE_TTS_BOUNDED_QUEUE_H
+#define JP_EDGE_TTS_BOUNDED_QUEUE_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
+
+namespace jp_edge_tts {
+
+/**
+ * @class BoundedQueue
+ * @brief Multi-producer multi-consumer queue with a capacity limit
+ *
+ * @details Push blocks while the queue is full, which propagates
+ * backpressure to upstream producers. Close() wakes all waiters:
+ * further pushes fail and Pop drains what is left, then returns
+ * std::nullopt.
+ *
+ * @tparam T Element type (must be movable)
+ */
+template<typename T>
+class BoundedQueue {
+public:
+    /**
+     * @brief Constructor
+     * @param max_size Maximum number of queued elements (minimum 1)
+     */
+    explicit BoundedQueue(size_t max_size)
+        : capacity(std::max<size_t>(1, max_size)) {}
+
+    // Disable copy and move
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    /**
+     * @brief Add an element, waiting for space if the queue is full
+     * @return false if the queue was closed
+     */
+    bool Push(T value) {
+        std::unique_lock<std::mutex> lock(queue_mutex);
+        not_full.wait(lock, [this] { return closed || items.size() < capacity; });
+        if (closed) {
+            return false;
+        }
+        items.push_back(std::move(value));
+        peak_size = std::max(peak_size, items.size());
+        lock.unlock();
+        not_empty.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief Add an element only if there is space
+     * @return false if the queue is full or closed
+     */
+    bool TryPush(T value) {
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            if (closed || items.size() >= capacity) {
+                return false;
+            }
+            items.push_back(std::move(value));
+            peak_size = std::max(peak_size, items.size());
+        }
+        not_empty.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief Remove the oldest element, waiting if the queue is empty
+     * @return The element, or std::nullopt once closed and drained
+     */
+    std::optional<T> Pop() {
+        std::unique_lock<std::mutex> lock(queue_mutex);
+        not_empty.wait(lock, [this] { return closed || !items.empty(); });
+        if (items.empty()) {
+            return std::nullopt;
+        }
+        T value = std::move(items.front());
+        items.pop_front();
+        lock.unlock();
+        not_full.notify_one();
+        return value;
+    }
+
+    /**
+     * @brief Reject further pushes and wake all waiting threads
+     */
+    void Close() {
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            closed = true;
+        }
+        not_full.notify_all();
+        not_empty.notify_all();
+    }
+
+    /**
+     * @brief Get current number of queued elements
+     */
+    size_t Size() const {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        return items.size();
+    }
+
+    /**
+     * @brief Get the largest size observed since construction
+     */
+    size_t PeakSize() const {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        return peak_size;
+    }
+
+    /**
+     * @brief Get maximum capacity
+     */
+    size_t Capacity() const { return capacity; }
+
+    /**
+     * @brief Check if Close() has been called
+     */
+    bool IsClosed() const {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        return closed;
+    }
+
+private:
+    const size_t capacity;
+    std::deque<T> items;
+    size_t peak_size = 0;
+    bool closed = false;
+
+    mutable std::mutex queue_mutex;
+    std::condition_variable not_full;
+    std::condition_variable not_empty;
+};
+
+} // namespace jp_edge_tts
+
+#endif // JP_EDGE_TTS_BOUNDED_QUEUE_H
@@ -0,0 +1,127 @@
+/**
+ * @file cancellation_token.h
+ * @brief Cooperative cancellation shared between a request and its workers
+ * @author JP Edge TTS Project
+ * @date 2024
+ *
+ * @copyright MIT License
+ */
+
+#ifndef JP_EDGE_TTS_CANCELLATION_TOKEN_H
+#define JP_EDGE_TTS_CANCELLATION_TOKEN_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
+namespace jp_edge_tts {
+
+/**
+ * @class CancellationToken
+ * @brief One-shot cancellation flag with abort callbacks
+ *
+ * @details Work checks IsCancelled() between steps. A blocking call
+ * that can be interrupted (such as an ONNX Runtime run) registers a
+ * callback for as long as it runs; Cancel() invokes it from the
+ * cancelling thread. Callbacks run under the token's lock, so once
+ * Unregister() returns the callback is guaranteed not to be running
+ * and whatever it captured may be destroyed. Keep callbacks short.
+ */
+class CancellationToken {
+public:
+    using Callback = std::function<void()>;
+
+    CancellationToken() = default;
+
+    // Shared by reference; not copyable
+    CancellationToken(const CancellationToken&) = delete;
+    CancellationToken& operator=(const CancellationToken&) = delete;
+
+    /**
+     * @brief Request cancellation and fire registered callbacks
+     * @return true if this call cancelled the token
+     */
+    bool Cancel() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (cancelled.exchange(true)) {
+            return false;
+        }
+        for (auto& [id, callback] : callbacks) {
+            callback();
+        }
+        return true;
+    }
+
+    /**
+     * @brief Check if cancellation was requested
+     */
+    bool IsCancelled() const {
+        return cancelled.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Register a callback to run on cancellation
+     *
+     * @details Runs immediately if the token is already cancelled.
+     *
+     * @param callback Abort action
+     * @return Handle for Unregister()
+     */
+    uint64_t Register(Callback callback) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (cancelled) {
+            callback();
+        }
+        uint64_t id = next_id++;
+        callbacks.emplace(id, std::move(callback));
+        return id;
+    }
+
+    /**
+     * @brief Remove a callback, waiting for it if Cancel() is running it
+     * @param id Handle returned by Register()
+     */
+    void Unregister(uint64_t id) {
+        std::lock_guard<std::mutex> lock(mutex);
+        callbacks.erase(id);
+    }
+
+private:
+    std::atomic<bool> cancelled{false};
+    std::mutex mutex;
+    std::unordered_map<uint64_t, Callback> callbacks;
+    uint64_t next_id = 0;
+};
+
+/**
+ * @class CancellationRegistration
+ * @brief Keeps a callback registered for the lifetime of a scope
+ */
+class CancellationRegistration {
+public:
+    CancellationRegistration(CancellationToken* token, CancellationToken::Callback callback)
+        : token(token) {
+        if (token) {
+            id = token->Register(std::move(callback));
+        }
+    }
+
+    ~CancellationRegistration() {
+        if (token) {
+            token->Unregister(id);
+        }
+    }
+
+    CancellationRegistration(const CancellationRegistration&) = delete;
+    CancellationRegistration& operator=(const CancellationRegistration&) = delete;
+
+private:
+    CancellationToken* token;
+    uint64_t id = 0;
+};
+
+} // namespace jp_edge_tts
+
+#endif // JP_EDGE_TTS_CANCELLATION_TOKEN_H
@@ -107,6 +107,14 @@ public:
      */
     static int64_t GetFileSize(const std::string& path);
 
+    /**
+     * @brief Get file modification time
+     *
+     * @param path File path
+     * @return Filesystem clock ticks, or -1 if error
+     */
+    static int64_t GetModificationTime(const std::string& path);
+
     /**
      * @brief Get file extension
      *
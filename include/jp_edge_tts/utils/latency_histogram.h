@@ -0,0 +1,125 @@
+/**
+ * @file latency_histogram.h
+ * @brief Lock-free log-bucketed latency histogram
+ * @author JP Edge TTS Project
+ * @date 2024
+ *
+ * @copyright MIT License
+ */
+
+#ifndef JP_EDGE_TTS_LATENCY_HISTOGRAM_H
+#define JP_EDGE_TTS_LATENCY_HISTOGRAM_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace jp_edge_tts {
+
+/**
+ * @class LatencyHistogram
+ * @brief HDR-style histogram of microsecond latencies
+ *
+ * @details Values below 32 us get exact buckets. Above that, each
+ * power-of-two range is split into 32 linear sub-buckets, so any
+ * recorded value is reported within ~3% of its true value. Values up
+ * to about 2^41 us (25 days) are kept; larger ones land in the top
+ * bucket.
+ *
+ * Recording is a relaxed atomic increment on one of several shards,
+ * chosen per thread, so concurrent writers rarely share cache lines
+ * and never take a lock. Readers merge all shards.
+ */
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BUCKET_BITS = 5;
+    static constexpr uint64_t SUB_BUCKET_COUNT = uint64_t{1} << SUB_BUCKET_BITS;
+    static constexpr int MAX_EXPONENT = 41;
+    static constexpr size_t BUCKET_COUNT = (MAX_EXPONENT - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+    static constexpr size_t SHARD_COUNT = 8;
+
+    /**
+     * @brief Merged view of a histogram at one point in time
+     */
+    struct Snapshot {
+        uint64_t count = 0;
+        uint64_t sum_us = 0;
+        uint64_t min_us = 0;
+        uint64_t max_us = 0;
+        std::vector<uint64_t> buckets;
+
+        /**
+         * @brief Get the value at a percentile
+         * @param percentile Percentile in [0, 100]
+         * @return Latency in microseconds (0 if empty)
+         */
+        uint64_t Percentile(double percentile) const;
+
+        /**
+         * @brief Get the mean latency in microseconds
+         */
+        double Mean() const;
+    };
+
+    LatencyHistogram();
+
+    // Disable copy and move
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    /**
+     * @brief Record one latency sample
+     */
+    void Record(std::chrono::microseconds latency);
+
+    /**
+     * @brief Record one latency sample in microseconds
+     */
+    void RecordMicros(uint64_t latency_us);
+
+    /**
+     * @brief Merge all shards into a snapshot
+     */
+    Snapshot GetSnapshot() const;
+
+    /**
+     * @brief Clear all samples
+     *
+     * @details Samples recorded concurrently with a reset may be lost.
+     */
+    void Reset();
+
+    /**
+     * @brief Map a value to its bucket index
+     */
+    static size_t BucketIndex(uint64_t value_us);
+
+    /**
+     * @brief Get the smallest value that maps to a bucket
+     */
+    static uint64_t BucketLowerBound(size_t index);
+
+    /**
+     * @brief Get the largest value that maps to a bucket
+     */
+    static uint64_t BucketUpperBound(size_t index);
+
+private:
+    struct alignas(64) Shard {
+        std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets;
+        std::atomic<uint64_t> count{0};
+        std::atomic<uint64_t> sum_us{0};
+        std::atomic<uint64_t> min_us{UINT64_MAX};
+        std::atomic<uint64_t> max_us{0};
+    };
+
+    Shard& LocalShard();
+
+    std::vector<Shard> shards;
+};
+
+} // namespace jp_edge_tts
+
+#endif // JP_EDGE_TTS_LATENCY_HISTOGRAM_H
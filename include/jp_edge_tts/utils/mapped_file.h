@@ -0,0 +1,77 @@
+/**
+ * @file mapped_file.h
+ * @brief Read-only memory-mapped files
+ * @author JP Edge TTS Project
+ * @date 2024
+ *
+ * @copyright MIT License
+ */
+
+#ifndef JP_EDGE_TTS_MAPPED_FILE_H
+#define JP_EDGE_TTS_MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+namespace jp_edge_tts {
+
+/**
+ * @class MappedFile
+ * @brief Maps a whole file read-only into the address space
+ *
+ * @details Pages come straight from the page cache, so every process
+ * that maps the same file shares one physical copy and nothing is read
+ * up front. The mapping stays valid until the object is destroyed or
+ * Close() is called; anything pointing into data() must not outlive it.
+ */
+class MappedFile {
+public:
+    /**
+     * @brief Access hints applied after mapping
+     */
+    struct Options {
+        bool prefetch = true;       ///< Start asynchronous readahead of the whole file
+        bool huge_pages = true;     ///< Ask for transparent huge pages where supported
+    };
+
+    MappedFile() = default;
+    ~MappedFile();
+
+    // Owns the mapping; not copyable
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /**
+     * @brief Map a file, replacing any current mapping
+     *
+     * @param path File to map
+     * @param options Access hints (best effort; unsupported hints are skipped)
+     * @return true if the file is mapped; empty files cannot be mapped
+     */
+    bool Open(const std::string& path, const Options& options);
+    bool Open(const std::string& path) { return Open(path, Options()); }
+
+    /**
+     * @brief Unmap the file
+     */
+    void Close();
+
+    bool IsOpen() const { return address != nullptr; }
+    const void* data() const { return address; }
+    size_t size() const { return length; }
+    const std::string& path() const { return file_path; }
+
+private:
+    void* address = nullptr;
+    size_t length = 0;
+    std::string file_path;
+#ifdef _WIN32
+    void* mapping_handle = nullptr;
+#endif
+};
+
+} // namespace jp_edge_tts
+
+#endif // JP_EDGE_TTS_MAPPED_FILE_H
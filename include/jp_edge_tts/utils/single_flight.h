@@ -0,0 +1,152 @@
+/**
+ * @file single_flight.h
+ * @brief Coalescing of concurrent identical computations
+ * @author JP Edge TTS Project
+ * @date 2024
+ *
+ * @copyright MIT License
+ */
+
+#ifndef JP_EDGE_TTS_SINGLE_FLIGHT_H
+#define JP_EDGE_TTS_SINGLE_FLIGHT_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+namespace jp_edge_tts {
+
+/**
+ * @class SingleFlight
+ * @brief Runs at most one computation per key at a time
+ *
+ * @details The first caller for a key (the leader) runs the function.
+ * Callers that arrive while it is running attach to the same call and
+ * receive a copy of its result, or its exception. The key is released
+ * as soon as the leader finishes, so later callers start a fresh call.
+ *
+ * @tparam Key Key type (must be hashable)
+ * @tparam Value Result type (must be copyable)
+ */
+template<typename Key, typename Value>
+class SingleFlight {
+public:
+    /**
+     * @brief Run fn for key, or wait for the identical call in flight
+     *
+     * @param key Identity of the computation
+     * @param fn Computation to run if no call for key is in flight
+     * @param attached Set to true if the result came from another caller
+     * @return Result of the leader's call
+     */
+    template<typename Fn>
+    Value Do(const Key& key, Fn&& fn, bool* attached = nullptr) {
+        return *DoUntil(key, std::forward<Fn>(fn),
+                        std::chrono::steady_clock::time_point::max(),
+                        [] { return false; }, attached);
+    }
+
+    /**
+     * @brief Like Do(), but an attached caller can stop waiting
+     *
+     * @details An attached caller gives up at its deadline, or when stop()
+     * returns true; stop is polled every kStopPollInterval. The leader
+     * always runs fn to completion.
+     *
+     * @param key Identity of the computation
+     * @param fn Computation to run if no call for key is in flight
+     * @param deadline When an attached caller stops waiting
+     * @param stop Polled while attached; true abandons the wait
+     * @param attached Set to true if the caller attached to another call
+     * @return Result of the leader's call, or std::nullopt if the caller gave up
+     */
+    template<typename Fn, typename Stop>
+    std::optional<Value> DoUntil(const Key& key, Fn&& fn,
+                                 std::chrono::steady_clock::time_point deadline,
+                                 Stop&& stop, bool* attached = nullptr) {
+        std::unique_lock<std::mutex> lock(calls_mutex);
+
+        auto it = calls.find(key);
+        if (it != calls.end()) {
+            auto shared = it->second;
+            lock.unlock();
+            attach_count++;
+            if (attached) *attached = true;
+
+            for (;;) {
+                auto now = std::chrono::steady_clock::now();
+                auto until = deadline - now > kStopPollInterval ? now + kStopPollInterval : deadline;
+                if (shared.wait_until(until) == std::future_status::ready) {
+                    return shared.get();
+                }
+                if (std::chrono::steady_clock::now() >= deadline || stop()) {
+                    return std::nullopt;
+                }
+            }
+        }
+
+        std::promise<Value> promise;
+        calls.emplace(key, promise.get_future().share());
+        lock.unlock();
+        leader_count++;
+        if (attached) *attached = false;
+
+        try {
+            Value value = fn();
+            Release(key);
+            promise.set_value(value);
+            return value;
+        } catch (...) {
+            Release(key);
+            promise.set_exception(std::current_exception());
+            throw;
+        }
+    }
+
+    static constexpr std::chrono::milliseconds kStopPollInterval{10};
+
+    /**
+     * @brief Get number of calls that ran the computation
+     */
+    size_t GetLeaderCount() const { return leader_count; }
+
+    /**
+     * @brief Get number of calls that attached to an in-flight call
+     */
+    size_t GetAttachCount() const { return attach_count; }
+
+    /**
+     * @brief Get number of keys currently in flight
+     */
+    size_t GetInFlightCount() const {
+        std::lock_guard<std::mutex> lock(calls_mutex);
+        return calls.size();
+    }
+
+    /**
+     * @brief Reset leader/attach counters
+     */
+    void ResetStats() {
+        leader_count = 0;
+        attach_count = 0;
+    }
+
+private:
+    void Release(const Key& key) {
+        std::lock_guard<std::mutex> lock(calls_mutex);
+        calls.erase(key);
+    }
+
+    std::unordered_map<Key, std::shared_future<Value>> calls;
+    mutable std::mutex calls_mutex;
+    std::atomic<size_t> leader_count{0};
+    std::atomic<size_t> attach_count{0};
+};
+
+} // namespace jp_edge_tts
+
+#endif // JP_EDGE_TTS_SINGLE_FLIGHT_H
@@ -58,6 +58,22 @@ public:
      */
     static std::string Trim(const std::string& str);
 
+    /**
+     * @brief Split text into sentences and clauses
+     *
+     * @details Always splits after sentence terminators (。！？!?．…) and
+     * newlines. Clause punctuation (、，,；;：:) only ends a piece once
+     * it holds at least min_clause_length code points, so short clauses
+     * stay attached to their neighbours. Punctuation is kept at the end
+     * of each piece and surrounding whitespace is trimmed.
+     *
+     * @param text Input UTF-8 text
+     * @param min_clause_length Minimum piece length before a clause split
+     * @return Vector of non-empty sentence/clause pieces
+     */
+    static std::vector<std::string> SplitSentences(const std::string& text,
+                                                   size_t min_clause_length = 0);
+
     /**
      * @brief Convert string to lowercase
      *
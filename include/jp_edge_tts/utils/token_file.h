@@ -0,0 +1,74 @@
+/**
+ * @file token_file.h
+ * @brief Compact binary storage for pre-tokenized utterances
+ * @author JP Edge TTS Project
+ * @date 2024
+ *
+ * @copyright MIT License
+ */
+
+#ifndef JP_EDGE_TTS_TOKEN_FILE_H
+#define JP_EDGE_TTS_TOKEN_FILE_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace jp_edge_tts {
+
+/**
+ * @brief One pre-tokenized utterance
+ */
+struct TokenRecord {
+    std::string id;                 ///< Caller-defined key (e.g. line number or asset name)
+    std::vector<int> tokens;        ///< Model token IDs, ready for TTSRequest::token_ids
+};
+
+/**
+ * @class TokenFile
+ * @brief Reads and writes token files produced offline
+ *
+ * @details Layout (little-endian):
+ * @code
+ *   char[4]  magic "JPTK"
+ *   uint16   format version (1)
+ *   uint16   bytes per token (1 or 2, smallest that fits every token)
+ *   uint32   vocabulary size the tokens were produced with
+ *   uint32   record count
+ *   records: uint16 id length, id bytes, uint32 token count, tokens
+ * @endcode
+ * The vocabulary size lets a reader reject files built for another
+ * tokenizer instead of synthesizing garbage.
+ */
+class TokenFile {
+public:
+    static constexpr uint16_t FORMAT_VERSION = 1;
+
+    /**
+     * @brief Write records to a token file
+     *
+     * @param path Output path
+     * @param records Utterances to store
+     * @param vocabulary_size Size of the vocabulary the tokens index
+     * @return true if successful; false if a token does not fit in 16 bits
+     */
+    static bool Write(const std::string& path,
+                      const std::vector<TokenRecord>& records,
+                      uint32_t vocabulary_size);
+
+    /**
+     * @brief Read all records from a token file
+     *
+     * @param path Token file path
+     * @param records Receives the stored utterances
+     * @param vocabulary_size Receives the stored vocabulary size (may be null)
+     * @return true if the file was read completely
+     */
+    static bool Read(const std::string& path,
+                     std::vector<TokenRecord>& records,
+                     uint32_t* vocabulary_size = nullptr);
+};
+
+} // namespace jp_edge_tts
+
+#endif // JP_EDGE_TTS_TOKEN_FILE_H
@@ -0,0 +1,112 @@
+/**
+ * @file trace.h
+ * @brief Low-overhead scoped span tracing with Chrome trace export
+ * @author JP Edge TTS Project
+ * @date 2024
+ *
+ * @copyright MIT License
+ */
+
+#ifndef JP_EDGE_TTS_TRACE_H
+#define JP_EDGE_TTS_TRACE_H
+
+#include <cstdint>
+#include <string>
+
+namespace jp_edge_tts {
+namespace trace {
+
+/**
+ * @brief Microseconds on the steady clock used for all span timestamps
+ */
+uint64_t NowMicros();
+
+/**
+ * @brief Record a completed span on the calling thread
+ *
+ * @details Spans go into a ring buffer owned by the calling thread; it
+ * grows on demand to a fixed limit, after which the oldest spans are
+ * overwritten. A thread's spans stay available after it exits, until
+ * Clear(). Name and category are stored by pointer and must be string
+ * literals.
+ *
+ * @param name Span name
+ * @param category Span category
+ * @param start_us Start time from NowMicros()
+ * @param duration_us Span duration in microseconds
+ */
+void RecordSpan(const char* name, const char* category,
+                uint64_t start_us, uint64_t duration_us);
+
+/**
+ * @brief Write all buffered spans as Chrome/Perfetto trace-event JSON
+ *
+ * @param path Output file path
+ * @return true if the file was written
+ */
+bool WriteChromeTrace(const std::string& path);
+
+/**
+ * @brief Discard all buffered spans
+ */
+void Clear();
+
+/**
+ * @brief Check whether span recording was compiled in
+ */
+constexpr bool IsEnabled() {
+#ifdef ENABLE_PROFILING
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @class ScopedSpan
+ * @brief Records a span covering its own lifetime
+ */
+class ScopedSpan {
+public:
+    explicit ScopedSpan(const char* name, const char* category = "tts")
+        : name(name), category(category), start_us(NowMicros()) {}
+
+    ~ScopedSpan() {
+        RecordSpan(name, category, start_us, NowMicros() - start_us);
+    }
+
+    ScopedSpan(const ScopedSpan&) = delete;
+    ScopedSpan& operator=(const ScopedSpan&) = delete;
+
+private:
+    const char* name;
+    const char* category;
+    uint64_t start_us;
+};
+
+} // namespace trace
+} // namespace jp_edge_tts
+
+#define JP_TRACE_CONCAT_INNER(a, b) a##b
+#define JP_TRACE_CONCAT(a, b) JP_TRACE_CONCAT_INNER(a, b)
+
+// Trace the enclosing scope, or a region between BEGIN and END that does
+// not map to a scope. All compile to nothing unless ENABLE_PROFILING.
+#ifdef ENABLE_PROFILING
+    #define JP_TRACE_SCOPE(name) \
+        ::jp_edge_tts::trace::ScopedSpan JP_TRACE_CONCAT(jp_trace_span_, __LINE__)(name)
+    #define JP_TRACE_SCOPE_CAT(name, category) \
+        ::jp_edge_tts::trace::ScopedSpan JP_TRACE_CONCAT(jp_trace_span_, __LINE__)(name, category)
+    #define JP_TRACE_BEGIN(id) \
+        const uint64_t jp_trace_begin_##id = ::jp_edge_tts::trace::NowMicros()
+    #define JP_TRACE_END(id, name) \
+        ::jp_edge_tts::trace::RecordSpan(name, "tts", jp_trace_begin_##id, \
+            ::jp_edge_tts::trace::NowMicros() - jp_trace_begin_##id)
+#else
+    #define JP_TRACE_SCOPE(name) ((void)0)
+    #define JP_TRACE_SCOPE_CAT(name, category) ((void)0)
+    #define JP_TRACE_BEGIN(id) ((void)0)
+    #define JP_TRACE_END(id, name) ((void)0)
+#endif
+
+#endif // JP_EDGE_TTS_TRACE_H
@@ -191,6 +191,38 @@ std::vector<float> AudioProcessor::ApplyFade(const std::vector<float>& samples,
     return result;
 }
 
+std::vector<float> AudioProcessor::ConcatenateWithCrossfade(
+    const std::vector<std::vector<float>>& segments,
+    int crossfade_ms) {
+
+    size_t total = 0;
+    for (const auto& segment : segments) {
+        total += segment.size();
+    }
+
+    std::vector<float> result;
+    result.reserve(total);
+
+    size_t fade_samples = crossfade_ms > 0 ?
+        static_cast<size_t>((crossfade_ms * pImpl->sample_rate) / 1000) : 0;
+
+    for (const auto& segment : segments) {
+        // Overlap can never exceed either side of the seam
+        size_t overlap = std::min({fade_samples, result.size(), segment.size()});
+        size_t offset = result.size() - overlap;
+
+        for (size_t i = 0; i < overlap; i++) {
+            float t = static_cast<float>(i + 1) / (overlap + 1);
+            float fade_in = 0.5f * (1.0f - std::cos(static_cast<float>(M_PI) * t));
+            result[offset + i] = result[offset + i] * (1.0f - fade_in) + segment[i] * fade_in;
+        }
+
+        result.insert(result.end(), segment.begin() + overlap, segment.end());
+    }
+
+    return result;
+}
+
 std::vector<float> AudioProcessor::Resample(const std::vector<float>& samples,
                                             int from_rate,
                                             int to_rate) {
@@ -238,10 +270,12 @@ AudioData AudioProcessor::LoadFromFile(const std::string& filepath) {
     AudioData result;
 
     // Use WAVWriter to read the file
-    bool success = WAVWriter::ReadWav(filepath, result.samples, result.sample_rate, result.channels);
+    std::vector<float> samples;
+    bool success = WAVWriter::ReadWav(filepath, samples, result.sample_rate, result.channels);
 
-    if (!success) {
-        result.samples.clear();
+    if (success) {
+        result.samples = std::move(samples);
+    } else {
         result.sample_rate = 0;
         result.channels = 0;
     }
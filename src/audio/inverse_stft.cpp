@@ -0,0 +1,141 @@
+/**
+ * @file inverse_stft.cpp
+ * @brief Implementation of the streaming inverse STFT
+ * @author D Everett Hinton
+ * @date 2025
+ *
+ * @copyright MIT License
+ */
+
+#include "jp_edge_tts/audio/inverse_stft.h"
+#include <algorithm>
+#include <cmath>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace jp_edge_tts {
+
+InverseSTFT::InverseSTFT(size_t n_fft, size_t hop_size)
+    : n_fft(std::max<size_t>(1, n_fft)),
+      hop_size(std::max<size_t>(1, hop_size)),
+      bins(this->n_fft / 2 + 1) {
+
+    // Periodic Hann, as torch.hann_window
+    std::vector<double> window(this->n_fft);
+    window_squared.resize(this->n_fft);
+    for (size_t n = 0; n < this->n_fft; n++) {
+        window[n] = 0.5 - 0.5 * std::cos(2.0 * M_PI * n / this->n_fft);
+        window_squared[n] = static_cast<float>(window[n] * window[n]);
+    }
+
+    // Real inverse DFT: DC and Nyquist count once, the other bins stand
+    // for their conjugate mirror as well
+    cos_basis.resize(bins * this->n_fft);
+    sin_basis.resize(bins * this->n_fft);
+    for (size_t k = 0; k < bins; k++) {
+        bool single = (k == 0) || (this->n_fft % 2 == 0 && k == this->n_fft / 2);
+        double scale = (single ? 1.0 : 2.0) / this->n_fft;
+        for (size_t n = 0; n < this->n_fft; n++) {
+            double angle = 2.0 * M_PI * static_cast<double>((k * n) % this->n_fft) / this->n_fft;
+            cos_basis[k * this->n_fft + n] = static_cast<float>(scale * std::cos(angle) * window[n]);
+            // Imaginary parts of DC and Nyquist are ignored, as in irfft
+            sin_basis[k * this->n_fft + n] = single ? 0.0f :
+                static_cast<float>(scale * std::sin(angle) * window[n]);
+        }
+    }
+
+    real.resize(bins);
+    imag.resize(bins);
+    frame.resize(this->n_fft);
+}
+
+std::vector<float> InverseSTFT::Transform(const float* magnitude, const float* phase, size_t frames) {
+    Reset();
+    std::vector<float> out;
+    out.reserve(frames > 0 ? hop_size * (frames - 1) : 0);
+    Push(magnitude, phase, frames, frames, out);
+    Finish(out);
+    return out;
+}
+
+void InverseSTFT::Push(const float* magnitude, const float* phase,
+                       size_t frames, size_t stride, std::vector<float>& out) {
+    for (size_t t = 0; t < frames; t++) {
+        for (size_t k = 0; k < bins; k++) {
+            float m = magnitude[k * stride + t];
+            float p = phase[k * stride + t];
+            real[k] = m * std::cos(p);
+            imag[k] = m * std::sin(p);
+        }
+
+        // Windowed inverse DFT, one basis row per bin
+        std::fill(frame.begin(), frame.end(), 0.0f);
+        for (size_t k = 0; k < bins; k++) {
+            const float re = real[k];
+            const float im = imag[k];
+            const float* c = &cos_basis[k * n_fft];
+            const float* s = &sin_basis[k * n_fft];
+            for (size_t n = 0; n < n_fft; n++) {
+                frame[n] += re * c[n] - im * s[n];
+            }
+        }
+
+        // Overlap-add at this frame's position
+        size_t offset = frames_seen * hop_size - buffer_start;
+        if (buffer.size() < offset + n_fft) {
+            buffer.resize(offset + n_fft, 0.0f);
+            envelope.resize(offset + n_fft, 0.0f);
+        }
+        float* acc = &buffer[offset];
+        float* env = &envelope[offset];
+        for (size_t n = 0; n < n_fft; n++) {
+            acc[n] += frame[n];
+            env[n] += window_squared[n];
+        }
+        frames_seen++;
+    }
+
+    // Samples before the next frame's start are final, but never emit
+    // past where the signal would end if this were the last frame
+    if (frames_seen > 0) {
+        Emit(std::min(frames_seen * hop_size, n_fft / 2 + hop_size * (frames_seen - 1)), out);
+    }
+}
+
+void InverseSTFT::Finish(std::vector<float>& out) {
+    if (frames_seen > 0) {
+        Emit(n_fft / 2 + hop_size * (frames_seen - 1), out);
+    }
+    Reset();
+}
+
+void InverseSTFT::Reset() {
+    buffer.clear();
+    envelope.clear();
+    buffer_start = 0;
+    frames_seen = 0;
+}
+
+void InverseSTFT::Emit(size_t end, std::vector<float>& out) {
+    if (end <= buffer_start) {
+        return;
+    }
+
+    // The first n_fft / 2 samples only exist because of centering
+    size_t begin = std::max(buffer_start, n_fft / 2);
+    for (size_t p = begin; p < end; p++) {
+        size_t i = p - buffer_start;
+        float value = i < buffer.size() ? buffer[i] : 0.0f;
+        float weight = i < envelope.size() ? envelope[i] : 0.0f;
+        out.push_back(weight > 1e-11f ? value / weight : value);
+    }
+
+    size_t consumed = std::min(end - buffer_start, buffer.size());
+    buffer.erase(buffer.begin(), buffer.begin() + consumed);
+    envelope.erase(envelope.begin(), envelope.begin() + consumed);
+    buffer_start = end;
+}
+
+} // namespace jp_edge_tts
@@ -9,6 +9,7 @@
 
 #include "jp_edge_tts/jp_edge_tts_c_api.h"
 #include "jp_edge_tts/core/tts_engine.h"
+#include "jp_edge_tts/audio/audio_processor.h"
 #include <iostream>
 #include <cstring>
 #include <memory>
@@ -64,6 +65,10 @@ namespace {
                 return JP_TTS_ERROR_VOICE_NOT_FOUND;
             case jp_edge_tts::Status::ERROR_CANCELLED:
                 return JP_TTS_ERROR_CANCELLED;
+            case jp_edge_tts::Status::ERROR_QUEUE_FULL:
+                return JP_TTS_ERROR_QUEUE_FULL;
+            case jp_edge_tts::Status::ERROR_TIMEOUT:
+                return JP_TTS_ERROR_TIMEOUT;
             case jp_edge_tts::Status::ERROR_FILE_WRITE_FAILED:
                 return JP_TTS_ERROR_FILE_WRITE_FAILED;
             default:
@@ -102,6 +107,8 @@ jp_tts_engine_t jp_tts_create_engine(const jp_tts_config_t* config) {
             cpp_config.sample_rate = config->sample_rate > 0 ? config->sample_rate : 22050;
             cpp_config.num_threads = config->num_threads > 0 ? config->num_threads : 4;
             cpp_config.cache_size_mb = config->cache_size_mb > 0 ? config->cache_size_mb : 100;
+            cpp_config.max_queue_size = config->max_queue_size >= 0 ?
+                static_cast<size_t>(config->max_queue_size) : jp_edge_tts::DEFAULT_QUEUE_SIZE;
         }
 
         auto engine = jp_edge_tts::CreateTTSEngine(cpp_config);
@@ -189,8 +196,8 @@ jp_tts_result_t jp_tts_synthesize_simple(jp_tts_engine_t engine,
 
 jp_tts_result_t jp_tts_synthesize(jp_tts_engine_t engine,
                                   const jp_tts_request_t* request) {
-    if (!request || !request->text) {
-        SetError("Request and text cannot be null");
+    if (!request || (!request->text && !(request->token_ids && request->token_count > 0))) {
+        SetError("Request needs text or token_ids");
         return 0;
     }
 
@@ -203,7 +210,9 @@ jp_tts_result_t jp_tts_synthesize(jp_tts_engine_t engine,
 
     try {
         jp_edge_tts::TTSRequest cpp_request;
-        cpp_request.text = request->text;
+        if (request->text) {
+            cpp_request.text = request->text;
+        }
 
         if (request->voice_id) {
             cpp_request.voice_id = request->voice_id;
@@ -211,10 +220,19 @@ jp_tts_result_t jp_tts_synthesize(jp_tts_engine_t engine,
         if (request->phonemes) {
             cpp_request.phonemes = request->phonemes;
         }
+        if (request->token_ids && request->token_count > 0) {
+            cpp_request.token_ids = std::vector<int>(request->token_ids,
+                                                     request->token_ids + request->token_count);
+        }
 
         cpp_request.speed = request->speed > 0 ? request->speed : 1.0f;
         cpp_request.pitch = request->pitch > 0 ? request->pitch : 1.0f;
         cpp_request.volume = request->volume > 0 ? request->volume : 1.0f;
+        cpp_request.diagnostics = static_cast<jp_edge_tts::Diagnostics>(request->diagnostics);
+        if (request->timeout_ms > 0) {
+            cpp_request.deadline = std::chrono::steady_clock::now() +
+                                   std::chrono::milliseconds(request->timeout_ms);
+        }
 
         auto result = engine_it->second->Synthesize(cpp_request);
 
@@ -261,7 +279,7 @@ size_t jp_tts_result_get_audio_size(jp_tts_result_t result) {
     if (it == g_results.end()) {
         return 0;
     }
-    return it->second->audio.data.size() * sizeof(float);
+    return it->second->audio.samples.size() * sizeof(float);
 }
 
 const float* jp_tts_result_get_audio_data(jp_tts_result_t result) {
@@ -270,7 +288,97 @@ const float* jp_tts_result_get_audio_data(jp_tts_result_t result) {
     if (it == g_results.end()) {
         return nullptr;
     }
-    return it->second->audio.data.data();
+    // Points into the shared buffer; no copy is made
+    return it->second->audio.samples.data();
+}
+
+jp_tts_status_t jp_tts_result_get_audio(jp_tts_result_t result,
+                                        jp_tts_audio_data_t* audio_data) {
+    if (!audio_data) {
+        SetError("Audio data cannot be null");
+        return JP_TTS_ERROR_INVALID_INPUT;
+    }
+
+    std::lock_guard<std::mutex> lock(g_results_mutex);
+    auto it = g_results.find(result);
+    if (it == g_results.end()) {
+        SetError("Invalid result handle");
+        return JP_TTS_ERROR_INVALID_INPUT;
+    }
+
+    // The result handle keeps the shared buffer alive until jp_tts_result_free
+    const auto& audio = it->second->audio;
+    audio_data->samples = audio.samples.data();
+    audio_data->sample_count = audio.samples.size();
+    audio_data->sample_rate = audio.sample_rate;
+    audio_data->channels = audio.channels;
+    audio_data->duration_ms = static_cast<int32_t>(audio.duration.count());
+    return JP_TTS_OK;
+}
+
+jp_tts_status_t jp_tts_result_get_wav_bytes(jp_tts_result_t result,
+                                            uint8_t* buffer,
+                                            size_t* buffer_size) {
+    if (!buffer_size) {
+        SetError("Buffer size cannot be null");
+        return JP_TTS_ERROR_INVALID_INPUT;
+    }
+
+    std::lock_guard<std::mutex> lock(g_results_mutex);
+    auto it = g_results.find(result);
+    if (it == g_results.end()) {
+        SetError("Invalid result handle");
+        return JP_TTS_ERROR_INVALID_INPUT;
+    }
+
+    const auto& audio = it->second->audio;
+    jp_edge_tts::AudioProcessor processor(audio.sample_rate);
+    auto wav = processor.ToWavBytes(audio, jp_edge_tts::AudioFormat::WAV_PCM16);
+
+    if (!buffer) {
+        *buffer_size = wav.size();
+        return JP_TTS_OK;
+    }
+    if (*buffer_size < wav.size()) {
+        *buffer_size = wav.size();
+        SetError("Buffer too small");
+        return JP_TTS_ERROR_INVALID_INPUT;
+    }
+
+    std::memcpy(buffer, wav.data(), wav.size());
+    *buffer_size = wav.size();
+    return JP_TTS_OK;
+}
+
+jp_tts_status_t jp_tts_result_get_phonemes(jp_tts_result_t result,
+                                           char* buffer,
+                                           size_t* buffer_size) {
+    if (!buffer_size) {
+        SetError("Buffer size cannot be null");
+        return JP_TTS_ERROR_INVALID_INPUT;
+    }
+
+    std::lock_guard<std::mutex> lock(g_results_mutex);
+    auto it = g_results.find(result);
+    if (it == g_results.end()) {
+        SetError("Invalid result handle");
+        return JP_TTS_ERROR_INVALID_INPUT;
+    }
+
+    const std::string& phonemes = it->second->diagnostics.phoneme_text;
+    if (!buffer) {
+        *buffer_size = phonemes.size() + 1;
+        return JP_TTS_OK;
+    }
+    if (*buffer_size <= phonemes.size()) {
+        *buffer_size = phonemes.size() + 1;
+        SetError("Buffer too small");
+        return JP_TTS_ERROR_INVALID_INPUT;
+    }
+
+    std::memcpy(buffer, phonemes.c_str(), phonemes.size() + 1);
+    *buffer_size = phonemes.size() + 1;
+    return JP_TTS_OK;
 }
 
 int jp_tts_result_get_sample_rate(jp_tts_result_t result) {
@@ -31,7 +31,7 @@ class CacheManager::Impl {
 public:
     struct CacheEntry {
         std::string key;
-        TTSResult result;
+        std::shared_ptr<const TTSResult> result;
         std::chrono::steady_clock::time_point created;
         std::chrono::steady_clock::time_point last_access;
         size_t access_count;
@@ -80,7 +80,11 @@ public:
     }
 
     void EvictLRU() {
-        while (!lru_list.empty() && current_size_bytes > max_size_bytes) {
+        EvictTo(max_size_bytes);
+    }
+
+    void EvictTo(size_t limit_bytes) {
+        while (!lru_list.empty() && current_size_bytes > limit_bytes) {
             std::string oldest_key = lru_list.back();
             lru_list.pop_back();
 
@@ -98,8 +102,7 @@ public:
     size_t CalculateMemorySize(const TTSResult& result) {
         size_t size = sizeof(TTSResult);
         size += result.audio.samples.size() * sizeof(float);
-        size += result.phonemes.size() * sizeof(PhonemeInfo);
-        size += result.tokens.size() * sizeof(TokenInfo);
+        size += result.diagnostics.GetMemorySize();
         size += result.error_message.size();
         return size;
     }
@@ -124,7 +127,7 @@ CacheManager::~CacheManager() = default;
 CacheManager::CacheManager(CacheManager&&) noexcept = default;
 CacheManager& CacheManager::operator=(CacheManager&&) noexcept = default;
 
-std::optional<TTSResult> CacheManager::Get(const std::string& key) {
+std::shared_ptr<const TTSResult> CacheManager::Get(const std::string& key) {
     std::lock_guard<std::mutex> lock(pImpl->cache_mutex);
 
     auto it = pImpl->cache.find(key);
@@ -136,7 +139,7 @@ std::optional<TTSResult> CacheManager::Get(const std::string& key) {
             pImpl->RemoveLRU(key);
             pImpl->cache.erase(it);
             pImpl->misses++;
-            return std::nullopt;
+            return nullptr;
         }
 
         // Update access info
@@ -151,7 +154,7 @@ std::optional<TTSResult> CacheManager::Get(const std::string& key) {
     }
 
     pImpl->misses++;
-    return std::nullopt;
+    return nullptr;
 }
 
 void CacheManager::Put(const std::string& key, const TTSResult& result) {
@@ -165,7 +168,7 @@ void CacheManager::Put(const std::string& key, const TTSResult& result) {
     if (it != pImpl->cache.end()) {
         // Update existing entry
         pImpl->current_size_bytes -= it->second.memory_size;
-        it->second.result = result;
+        it->second.result = std::make_shared<const TTSResult>(result);
         it->second.memory_size = memory_size;
         it->second.last_access = std::chrono::steady_clock::now();
         it->second.access_count++;
@@ -177,7 +180,7 @@ void CacheManager::Put(const std::string& key, const TTSResult& result) {
         // Create new entry
         Impl::CacheEntry entry;
         entry.key = key;
-        entry.result = result;
+        entry.result = std::make_shared<const TTSResult>(result);
         entry.created = std::chrono::steady_clock::now();
         entry.last_access = entry.created;
         entry.access_count = 1;
@@ -263,6 +266,14 @@ size_t CacheManager::GetCurrentSize() const {
     return pImpl->current_size_bytes;
 }
 
+size_t CacheManager::TrimTo(size_t target_bytes) {
+    std::lock_guard<std::mutex> lock(pImpl->cache_mutex);
+
+    size_t before = pImpl->current_size_bytes;
+    pImpl->EvictTo(target_bytes);
+    return before - pImpl->current_size_bytes;
+}
+
 size_t CacheManager::GetEntryCount() const {
     std::lock_guard<std::mutex> lock(pImpl->cache_mutex);
     return pImpl->cache.size();
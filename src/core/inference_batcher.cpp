@@ -0,0 +1,192 @@
+/**
+ * @file inference_batcher.cpp
+ * @brief Implementation of dynamic micro-batching
+ * @author D Everett Hinton
+ * @date 2025
+ *
+ * @copyright MIT License
+ */
+
+#include "jp_edge_tts/core/inference_batcher.h"
+#include "jp_edge_tts/core/session_manager.h"
+#include "jp_edge_tts/utils/cancellation_token.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+
+namespace jp_edge_tts {
+
+// ==========================================
+// Private Implementation
+// ==========================================
+
+class InferenceBatcher::Impl {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Pending {
+        const std::vector<int>* tokens;
+        const std::vector<float>* style_vector;
+        float speed;
+        Clock::time_point enqueued;
+        std::vector<float> audio;
+        bool done = false;
+    };
+
+    struct Bucket {
+        std::deque<std::shared_ptr<Pending>> items;
+        bool collecting = false;
+    };
+
+    // Bucket key: (length bucket, speed)
+    using BucketKey = std::pair<size_t, float>;
+
+    SessionManager& session;
+    size_t max_batch_size;
+    std::chrono::milliseconds max_wait;
+    size_t bucket_tokens;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::map<BucketKey, Bucket> buckets;
+
+    mutable std::mutex stats_mutex;
+    BatchStats stats;
+
+    Impl(SessionManager& s, size_t batch, int wait_ms, size_t width)
+        : session(s),
+          max_batch_size(std::max<size_t>(1, batch)),
+          max_wait(std::max(0, wait_ms)),
+          bucket_tokens(std::max<size_t>(1, width)) {}
+
+    std::vector<float> Infer(const std::vector<int>& tokens,
+                             const std::vector<float>& style_vector,
+                             float speed,
+                             float pitch,
+                             CancellationToken* cancel) {
+        if (max_batch_size <= 1 || pitch != 1.0f || !session.SupportsBatching()) {
+            return session.RunInference(tokens, style_vector, speed, pitch, cancel);
+        }
+        if (cancel && cancel->IsCancelled()) {
+            return {};
+        }
+
+        auto item = std::make_shared<Pending>();
+        item->tokens = &tokens;
+        item->style_vector = &style_vector;
+        item->speed = speed;
+        item->enqueued = Clock::now();
+
+        BucketKey key{tokens.size() / bucket_tokens, speed};
+
+        std::unique_lock<std::mutex> lock(mutex);
+        Bucket& bucket = buckets[key];
+        bucket.items.push_back(item);
+        if (bucket.items.size() >= max_batch_size) {
+            cv.notify_all();
+        }
+
+        while (!item->done) {
+            if (bucket.collecting) {
+                cv.wait(lock);
+                continue;
+            }
+            CollectAndRun(bucket, lock);
+        }
+
+        // Other finished callers may already have dropped the bucket
+        auto it = buckets.find(key);
+        if (it != buckets.end() && it->second.items.empty() && !it->second.collecting) {
+            buckets.erase(it);
+        }
+        return std::move(item->audio);
+    }
+
+    /**
+     * @brief Wait for the bucket to fill, then run one batch from its front
+     * @note Called with the lock held; releases it while inferring
+     */
+    void CollectAndRun(Bucket& bucket, std::unique_lock<std::mutex>& lock) {
+        bucket.collecting = true;
+
+        auto deadline = bucket.items.front()->enqueued + max_wait;
+        cv.wait_until(lock, deadline, [&]() {
+            return bucket.items.size() >= max_batch_size;
+        });
+
+        size_t count = std::min(max_batch_size, bucket.items.size());
+        std::vector<std::shared_ptr<Pending>> batch(bucket.items.begin(),
+                                                    bucket.items.begin() + count);
+        bucket.items.erase(bucket.items.begin(), bucket.items.begin() + count);
+        lock.unlock();
+
+        std::vector<std::vector<int>> batch_tokens;
+        std::vector<std::vector<float>> style_vectors;
+        std::vector<float> speeds;
+        batch_tokens.reserve(count);
+        style_vectors.reserve(count);
+        speeds.reserve(count);
+        for (const auto& pending : batch) {
+            batch_tokens.push_back(*pending->tokens);
+            style_vectors.push_back(*pending->style_vector);
+            speeds.push_back(pending->speed);
+        }
+
+        std::vector<std::vector<float>> outputs;
+        try {
+            outputs = session.RunBatchInference(batch_tokens, style_vectors, speeds);
+        } catch (...) {
+            // Leave outputs empty; callers see a failed inference
+        }
+
+        {
+            std::lock_guard<std::mutex> stats_lock(stats_mutex);
+            stats.total_batches++;
+            stats.total_items += count;
+            stats.max_observed_batch = std::max(stats.max_observed_batch, count);
+        }
+
+        lock.lock();
+        for (size_t i = 0; i < count; i++) {
+            if (i < outputs.size()) {
+                batch[i]->audio = std::move(outputs[i]);
+            }
+            batch[i]->done = true;
+        }
+        bucket.collecting = false;
+        cv.notify_all();
+    }
+};
+
+// ==========================================
+// Public Interface Implementation
+// ==========================================
+
+InferenceBatcher::InferenceBatcher(SessionManager& session,
+                                   size_t max_batch_size,
+                                   int max_wait_ms,
+                                   size_t bucket_tokens)
+    : pImpl(std::make_unique<Impl>(session, max_batch_size, max_wait_ms, bucket_tokens)) {}
+
+InferenceBatcher::~InferenceBatcher() = default;
+
+std::vector<float> InferenceBatcher::Infer(const std::vector<int>& tokens,
+                                           const std::vector<float>& style_vector,
+                                           float speed,
+                                           float pitch,
+                                           CancellationToken* cancel) {
+    return pImpl->Infer(tokens, style_vector, speed, pitch, cancel);
+}
+
+InferenceBatcher::BatchStats InferenceBatcher::GetStats() const {
+    std::lock_guard<std::mutex> lock(pImpl->stats_mutex);
+    BatchStats result = pImpl->stats;
+    result.average_batch_size = result.total_batches > 0 ?
+        static_cast<double>(result.total_items) / result.total_batches : 0.0;
+    return result;
+}
+
+} // namespace jp_edge_tts
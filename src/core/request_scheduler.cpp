@@ -0,0 +1,239 @@
+/**
+ * @file request_scheduler.cpp
+ * @brief Implementation of priority-aware request scheduling
+ * @author D Everett Hinton
+ * @date 2025
+ *
+ * @copyright MIT License
+ */
+
+#include "jp_edge_tts/core/request_scheduler.h"
+#include <array>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace jp_edge_tts {
+
+// ==========================================
+// Private Implementation
+// ==========================================
+
+class RequestScheduler::Impl {
+public:
+    static constexpr size_t NUM_PRIORITIES = static_cast<size_t>(Priority::CRITICAL) + 1;
+
+    struct Entry {
+        std::string id;
+        Task run;
+        Task on_cancel;
+    };
+
+    struct Location {
+        size_t level;
+        std::list<Entry>::iterator it;
+    };
+
+    // One FIFO per priority level, indexed by static_cast<size_t>(Priority)
+    std::array<std::list<Entry>, NUM_PRIORITIES> queues;
+    std::unordered_map<std::string, Location> queued;
+    std::unordered_set<std::string> running;
+
+    std::vector<std::thread> workers;
+    size_t max_queue_size;
+    mutable std::mutex mutex;
+    std::condition_variable condition;
+    bool stop = false;
+
+    Impl(size_t num_workers, size_t max_queued) : max_queue_size(max_queued) {
+        if (num_workers == 0) {
+            num_workers = std::thread::hardware_concurrency();
+            if (num_workers == 0) num_workers = 4;  // Fallback
+        }
+
+        for (size_t i = 0; i < num_workers; ++i) {
+            workers.emplace_back([this] { WorkerLoop(); });
+        }
+    }
+
+    void WorkerLoop() {
+        for (;;) {
+            Entry entry;
+
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                condition.wait(lock, [this] { return stop || !queued.empty(); });
+
+                if (stop) {
+                    return;
+                }
+
+                // Highest priority level first
+                for (size_t level = NUM_PRIORITIES; level-- > 0;) {
+                    if (!queues[level].empty()) {
+                        entry = std::move(queues[level].front());
+                        queues[level].pop_front();
+                        break;
+                    }
+                }
+
+                queued.erase(entry.id);
+                running.insert(entry.id);
+            }
+
+            try {
+                entry.run();
+            } catch (...) {
+                // Tasks report their own errors; keep the worker alive
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                running.erase(entry.id);
+            }
+        }
+    }
+
+    std::vector<Entry> DrainQueued() {
+        std::vector<Entry> drained;
+        for (auto& queue : queues) {
+            for (auto& entry : queue) {
+                drained.push_back(std::move(entry));
+            }
+            queue.clear();
+        }
+        queued.clear();
+        return drained;
+    }
+};
+
+// ==========================================
+// Public Interface Implementation
+// ==========================================
+
+RequestScheduler::RequestScheduler(size_t num_workers, size_t max_queue_size)
+    : pImpl(std::make_unique<Impl>(num_workers, max_queue_size)) {}
+
+RequestScheduler::~RequestScheduler() {
+    Shutdown();
+}
+
+std::optional<size_t> RequestScheduler::Submit(const std::string& request_id,
+                                               Priority priority,
+                                               Task run,
+                                               Task on_cancel,
+                                               size_t* position_out) {
+    size_t level = static_cast<size_t>(priority);
+    size_t position = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(pImpl->mutex);
+
+        if (pImpl->stop) {
+            throw std::runtime_error("submit on stopped RequestScheduler");
+        }
+
+        if (pImpl->max_queue_size > 0 && pImpl->queued.size() >= pImpl->max_queue_size) {
+            return std::nullopt;
+        }
+
+        // Everything queued at this level or above runs first
+        for (size_t l = level; l < Impl::NUM_PRIORITIES; ++l) {
+            position += pImpl->queues[l].size();
+        }
+
+        // Workers pop under this lock, so run sees the write
+        if (position_out) {
+            *position_out = position;
+        }
+
+        auto& queue = pImpl->queues[level];
+        queue.push_back(Impl::Entry{request_id, std::move(run), std::move(on_cancel)});
+        pImpl->queued[request_id] = Impl::Location{level, std::prev(queue.end())};
+    }
+
+    pImpl->condition.notify_one();
+    return position;
+}
+
+bool RequestScheduler::Cancel(const std::string& request_id) {
+    Task on_cancel;
+
+    {
+        std::lock_guard<std::mutex> lock(pImpl->mutex);
+
+        auto it = pImpl->queued.find(request_id);
+        if (it == pImpl->queued.end()) {
+            return false;
+        }
+
+        on_cancel = std::move(it->second.it->on_cancel);
+        pImpl->queues[it->second.level].erase(it->second.it);
+        pImpl->queued.erase(it);
+    }
+
+    // Run outside the lock; the handler may touch the scheduler
+    if (on_cancel) {
+        on_cancel();
+    }
+    return true;
+}
+
+bool RequestScheduler::IsPending(const std::string& request_id) const {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    return pImpl->queued.count(request_id) > 0 ||
+           pImpl->running.count(request_id) > 0;
+}
+
+size_t RequestScheduler::GetQueueSize() const {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    return pImpl->queued.size();
+}
+
+size_t RequestScheduler::GetQueueSize(Priority priority) const {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    return pImpl->queues[static_cast<size_t>(priority)].size();
+}
+
+size_t RequestScheduler::GetActiveCount() const {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    return pImpl->running.size();
+}
+
+size_t RequestScheduler::GetWorkerCount() const {
+    return pImpl->workers.size();
+}
+
+void RequestScheduler::Shutdown() {
+    std::vector<Impl::Entry> drained;
+
+    {
+        std::lock_guard<std::mutex> lock(pImpl->mutex);
+        if (pImpl->stop) {
+            return;
+        }
+        pImpl->stop = true;
+        drained = pImpl->DrainQueued();
+    }
+
+    pImpl->condition.notify_all();
+
+    for (auto& entry : drained) {
+        if (entry.on_cancel) {
+            entry.on_cancel();
+        }
+    }
+
+    for (std::thread& worker : pImpl->workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+} // namespace jp_edge_tts
@@ -8,15 +8,207 @@
  */
 
 #include "jp_edge_tts/core/session_manager.h"
+#include "jp_edge_tts/audio/inverse_stft.h"
+#include "jp_edge_tts/config.h"
+#include "jp_edge_tts/utils/cancellation_token.h"
+#include "jp_edge_tts/utils/file_utils.h"
+#include "jp_edge_tts/utils/mapped_file.h"
+#include "jp_edge_tts/utils/trace.h"
 #include <onnxruntime_cxx_api.h>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <map>
+#include <sstream>
 #include <algorithm>
 #include <numeric>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
 
 namespace jp_edge_tts {
 
+namespace {
+
+/**
+ * @brief Process-wide ONNX Runtime environment
+ *
+ * @details Every session is created in this environment so that they can
+ * share its CPU arena allocator (registered once, used by sessions that
+ * set session.use_env_allocators) instead of each growing its own arena.
+ */
+std::shared_ptr<Ort::Env> SharedEnv() {
+    static std::mutex env_mutex;
+    static std::weak_ptr<Ort::Env> shared;
+
+    std::lock_guard<std::mutex> lock(env_mutex);
+    auto env = shared.lock();
+    if (!env) {
+        env = std::make_shared<Ort::Env>(ORT_LOGGING_LEVEL_WARNING, "jp_edge_tts");
+        auto memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+        // Defaults: no limit, power-of-two extension
+        Ort::ArenaCfg arena_cfg(0, -1, -1, -1);
+        env->CreateAndRegisterAllocator(memory_info, arena_cfg);
+        shared = env;
+    }
+    return env;
+}
+
+/**
+ * @brief 64-bit FNV-1a; stable across builds, unlike std::hash
+ */
+uint64_t Fnv1a(const char* data, size_t size, uint64_t hash = 0xcbf29ce484222325ULL) {
+    for (size_t i = 0; i < size; i++) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+/**
+ * @brief Hash a file's contents
+ *
+ * @param mapping The file already mapped, to hash without reading it again (may be null)
+ * @return Hash, or 0 if the file cannot be read
+ */
+uint64_t HashFile(const std::string& path, const MappedFile* mapping) {
+    if (mapping) {
+        uint64_t hash = Fnv1a(static_cast<const char*>(mapping->data()), mapping->size());
+        return hash == 0 ? 1 : hash;
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return 0;
+    }
+
+    std::vector<char> buffer(1 << 20);
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    while (file) {
+        file.read(buffer.data(), buffer.size());
+        hash = Fnv1a(buffer.data(), static_cast<size_t>(file.gcount()), hash);
+    }
+    return hash == 0 ? 1 : hash;
+}
+
+/**
+ * @brief Hash a file, reusing the hash recorded in a sidecar while the
+ * file's size and modification time are unchanged
+ *
+ * @details Hashing a large model costs about as much as loading the
+ * optimized artifact, so it is only done when the file changed.
+ */
+uint64_t HashFileCached(const std::string& path, const std::string& sidecar,
+                        const MappedFile* mapping) {
+    int64_t size = FileUtils::GetFileSize(path);
+    int64_t mtime = FileUtils::GetModificationTime(path);
+    if (size < 0 || mtime < 0) {
+        return 0;
+    }
+
+    std::istringstream recorded(FileUtils::ReadTextFile(sidecar));
+    long long recorded_size = -1, recorded_mtime = -1;
+    unsigned long long recorded_hash = 0;
+    if (recorded >> recorded_size >> recorded_mtime >> recorded_hash &&
+        recorded_size == size && recorded_mtime == mtime && recorded_hash != 0) {
+        return recorded_hash;
+    }
+
+    uint64_t hash = HashFile(path, mapping);
+    if (hash != 0) {
+        FileUtils::WriteTextFile(sidecar, std::to_string(size) + " " + std::to_string(mtime) +
+                                          " " + std::to_string(hash) + "\n");
+    }
+    return hash;
+}
+
+/**
+ * @brief Instruction sets that change which kernels ORT_ENABLE_ALL lays out
+ */
+std::string CpuFeatureTag() {
+    std::string tag;
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+    __builtin_cpu_init();
+    tag = "x86";
+    if (__builtin_cpu_supports("avx")) tag += "-avx";
+    if (__builtin_cpu_supports("avx2")) tag += "-avx2";
+    if (__builtin_cpu_supports("fma")) tag += "-fma";
+    if (__builtin_cpu_supports("avx512f")) tag += "-avx512f";
+    if (__builtin_cpu_supports("avx512bw")) tag += "-avx512bw";
+#elif defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    tag = "x86";
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    tag = "arm64";
+#else
+    tag = "generic";
+#endif
+    return tag;
+}
+
+std::basic_string<ORTCHAR_T> OrtPath(const std::string& path) {
+    return std::basic_string<ORTCHAR_T>(path.begin(), path.end());
+}
+
+/**
+ * @brief Find the outputs of a graph exported without its final iSTFT
+ *
+ * @param names Output names
+ * @param magnitude Receives the linear magnitude output's index
+ * @param phase Receives the phase output's index
+ * @return true if the graph ends at magnitude and phase
+ */
+bool FindSpectralOutputs(const std::vector<std::string>& names, int& magnitude, int& phase) {
+    magnitude = -1;
+    phase = -1;
+    for (size_t i = 0; i < names.size(); i++) {
+        if (magnitude < 0 && names[i].find("mag") != std::string::npos) {
+            magnitude = static_cast<int>(i);
+        } else if (phase < 0 && names[i].find("phase") != std::string::npos) {
+            phase = static_cast<int>(i);
+        }
+    }
+    return magnitude >= 0 && phase >= 0;
+}
+
+/**
+ * @brief Check that a [1, bins, frames] output matches the native iSTFT
+ */
+void CheckSpectralShape(const std::vector<int64_t>& shape, const std::string& name) {
+    const int64_t bins = KOKORO_ISTFT_N_FFT / 2 + 1;
+    if (shape.size() != 3 || (shape[1] > 0 && shape[1] != bins)) {
+        throw std::runtime_error("Output '" + name + "' is not a [1, " +
+                                 std::to_string(bins) + ", frames] spectrogram");
+    }
+}
+
+} // namespace
+
+SessionManager::PoolLayout SessionManager::ResolvePoolLayout(size_t num_sessions,
+                                                             int threads_per_session,
+                                                             size_t max_concurrent,
+                                                             unsigned int cores) {
+    cores = std::max(1u, cores);
+
+    PoolLayout layout;
+    layout.num_sessions = num_sessions;
+    if (layout.num_sessions == 0) {
+        // One session per concurrent request, but keep at least two
+        // cores per session so each run still gets some parallelism
+        layout.num_sessions = std::min<size_t>(std::max<size_t>(1, max_concurrent),
+                                               std::max(1u, cores / 2));
+    }
+
+    layout.threads_per_session = threads_per_session;
+    if (layout.threads_per_session <= 0) {
+        layout.threads_per_session = std::max(1, static_cast<int>(cores / layout.num_sessions));
+    }
+    return layout;
+}
+
 // ==========================================
 // Private Implementation
 // ==========================================
@@ -24,17 +216,77 @@ namespace jp_edge_tts {
 class SessionManager::Impl {
 public:
     // ONNX Runtime components
-    std::unique_ptr<Ort::Env> env;
+    std::shared_ptr<Ort::Env> env;
     std::unique_ptr<Ort::SessionOptions> session_options;
-    std::unique_ptr<Ort::Session> session;
+    std::unique_ptr<Ort::PrepackedWeightsContainer> prepacked_weights;
     std::unique_ptr<Ort::AllocatorWithDefaultOptions> allocator;
     std::unique_ptr<Ort::MemoryInfo> memory_info;
 
+    /**
+     * @brief One pooled session with the buffers its runs reuse
+     *
+     * @details Only the thread holding the lease touches these, so the
+     * input buffers keep their capacity from run to run and the binding
+     * is set up once with the audio output.
+     */
+    struct PooledSession {
+        std::unique_ptr<Ort::Session> session;
+        std::unique_ptr<Ort::IoBinding> binding;
+        std::vector<int64_t> token_buffer;
+        std::vector<float> style_buffer;
+        float speed = 1.0f;
+        float pitch = 1.0f;
+        std::unique_ptr<Ort::Session> vocoder;  // Split model only
+        InverseSTFT istft{KOKORO_ISTFT_N_FFT, KOKORO_ISTFT_HOP};  // Spectral output only
+    };
+
+    /**
+     * @brief How one vocoder input is fed
+     */
+    struct VocoderInput {
+        std::string name;
+        int feature_output = -1;  // Acoustic output sliced into windows (-1 = style)
+        int64_t style_dim = -1;   // Style values passed (-1 = all)
+    };
+
+    // Mapped model files; declared before the pool so that sessions,
+    // which may point into the mapping, are destroyed first
+    std::vector<std::unique_ptr<MappedFile>> model_mappings;
+    std::vector<std::unique_ptr<MappedFile>> loading_mappings;  // For the pool being built
+
+    // Session pool; all sessions share the environment allocator and
+    // prepacked weights, and each request checks one out for its run
+    std::vector<std::unique_ptr<PooledSession>> sessions;
+    std::vector<PooledSession*> idle_sessions;
+    std::mutex pool_mutex;
+    std::condition_variable session_returned;
+
     // Model information
     std::vector<std::string> input_names;
     std::vector<std::string> output_names;
     std::vector<std::vector<int64_t>> input_shapes;
     std::vector<std::vector<int64_t>> output_shapes;
+    std::vector<const char*> input_names_raw;   // Point into input_names
+    std::vector<const char*> output_names_raw;  // Point into output_names
+    int duration_output_index = -1;  // Per-token predicted frames, if exported
+    bool supports_batching = false;
+
+    // Graphs exported without the generator's iSTFT end at magnitude and
+    // phase; the waveform is then finished natively
+    int magnitude_output = -1;
+    int phase_output = -1;
+
+    // Vocoder information (split model)
+    std::vector<VocoderInput> vocoder_inputs;
+    std::vector<const char*> vocoder_input_names_raw;  // Point into vocoder_inputs
+    std::vector<std::string> vocoder_output_names;      // Waveform, or magnitude and phase
+    std::vector<const char*> vocoder_output_names_raw;  // Point into vocoder_output_names
+    bool vocoder_spectral = false;
+
+    // Memory accounting
+    size_t model_bytes = 0;                     // Serialized weights held by the session
+    std::atomic<size_t> peak_tensor_bytes{0};   // Largest input+output set since last shrink
+    std::atomic<bool> shrink_pending{false};
 
     // Statistics
     mutable std::mutex stats_mutex;
@@ -45,12 +297,74 @@ public:
 
     // Configuration
     bool use_gpu = false;
-    int num_threads = 0;  // 0 = auto
+    int num_threads = 0;        // Intra-op threads per session (0 = auto)
+    int inter_op_threads = 0;   // 0 = sequential execution within a session
+    bool allow_spinning = true; // Idle pool threads spin before sleeping
+    size_t pool_size = 0;       // Sessions in the pool (0 = auto)
+    size_t max_concurrent = 1;  // Expected concurrent runs, sizes the auto pool
+    bool cache_optimized = false;
+    bool use_mmap = false;            // Map model files instead of letting ORT read them
+    std::string optimized_cache_dir;  // Empty = next to the model
+    std::string vocoder_path;         // Empty = single graph
+    size_t vocoder_window_frames = 32;
+    size_t vocoder_context_frames = 8;
     bool loaded = false;
 
+    LoadStats load_stats;
+    std::chrono::milliseconds hash_time{0};  // Spent keying the optimized cache on the last load
+
+    /**
+     * @brief Exclusive use of one pooled session for the duration of a scope
+     */
+    class SessionLease {
+    public:
+        explicit SessionLease(Impl& owner) : owner(owner) {
+            std::unique_lock<std::mutex> lock(owner.pool_mutex);
+            owner.session_returned.wait(lock, [this]() { return !this->owner.idle_sessions.empty(); });
+            session = owner.idle_sessions.back();
+            owner.idle_sessions.pop_back();
+        }
+
+        /**
+         * @brief Lease the first idle session not in skip
+         */
+        SessionLease(Impl& owner, const std::vector<PooledSession*>& skip) : owner(owner) {
+            auto wanted = [&skip](PooledSession* candidate) {
+                return std::find(skip.begin(), skip.end(), candidate) == skip.end();
+            };
+            std::unique_lock<std::mutex> lock(owner.pool_mutex);
+            std::vector<PooledSession*>::iterator found;
+            owner.session_returned.wait(lock, [&]() {
+                found = std::find_if(this->owner.idle_sessions.begin(),
+                                     this->owner.idle_sessions.end(), wanted);
+                return found != this->owner.idle_sessions.end();
+            });
+            session = *found;
+            owner.idle_sessions.erase(found);
+        }
+
+        ~SessionLease() {
+            {
+                std::lock_guard<std::mutex> lock(owner.pool_mutex);
+                owner.idle_sessions.push_back(session);
+            }
+            // Waiters may want different sessions
+            owner.session_returned.notify_all();
+        }
+
+        SessionLease(const SessionLease&) = delete;
+        SessionLease& operator=(const SessionLease&) = delete;
+
+        PooledSession& operator*() const { return *session; }
+        PooledSession* operator->() const { return session; }
+
+    private:
+        Impl& owner;
+        PooledSession* session;
+    };
+
     Impl() {
-        // Create ONNX Runtime environment
-        env = std::make_unique<Ort::Env>(ORT_LOGGING_LEVEL_WARNING, "jp_edge_tts");
+        env = SharedEnv();
         allocator = std::make_unique<Ort::AllocatorWithDefaultOptions>();
         memory_info = std::make_unique<Ort::MemoryInfo>(
             Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault)
@@ -61,53 +375,322 @@ public:
         // Cleanup happens automatically with unique_ptrs
     }
 
-    bool LoadModel(const std::string& model_path) {
+    /**
+     * @brief Build options for one session of the pool
+     *
+     * @param layout Resolved pool layout
+     * @param level Graph optimization level
+     * @param ort_format true when loading an ORT format model
+     */
+    std::unique_ptr<Ort::SessionOptions> MakeSessionOptions(const PoolLayout& layout,
+                                                            GraphOptimizationLevel level,
+                                                            bool ort_format = false) {
+        auto options = std::make_unique<Ort::SessionOptions>();
+        options->SetGraphOptimizationLevel(level);
+
+        if (ort_format) {
+            options->AddConfigEntry("session.load_model_format", "ORT");
+            if (use_mmap) {
+                // Run from the mapped bytes: initializers point into the
+                // page cache instead of being copied into private memory
+                options->AddConfigEntry("session.use_ort_model_bytes_directly", "1");
+                options->AddConfigEntry("session.use_ort_model_bytes_for_initializers", "1");
+            }
+        }
+
+        // Bounded threads per session; concurrency comes from the pool
+        options->SetIntraOpNumThreads(layout.threads_per_session);
+        if (inter_op_threads > 0) {
+            options->SetExecutionMode(ExecutionMode::ORT_PARALLEL);
+            options->SetInterOpNumThreads(inter_op_threads);
+        } else {
+            options->SetExecutionMode(ExecutionMode::ORT_SEQUENTIAL);
+        }
+
+        // Allocate from the environment's shared arena
+        options->AddConfigEntry("session.use_env_allocators", "1");
+
+        // Spinning cuts wake-up latency but burns cores other sessions could use
+        options->AddConfigEntry("session.intra_op.allow_spinning", allow_spinning ? "1" : "0");
+        options->AddConfigEntry("session.inter_op.allow_spinning", allow_spinning ? "1" : "0");
+
+        // GPU configuration
+        if (use_gpu) {
+            #ifdef USE_CUDA
+            OrtCUDAProviderOptions cuda_options;
+            cuda_options.device_id = 0;
+            cuda_options.arena_extend_strategy = 0;
+            cuda_options.gpu_mem_limit = SIZE_MAX;
+            cuda_options.cudnn_conv_algo_search = OrtCudnnConvAlgoSearch::EXHAUSTIVE;
+            cuda_options.do_copy_in_default_stream = 1;
+
+            options->AppendExecutionProvider_CUDA(cuda_options);
+            #endif
+        }
+        return options;
+    }
+
+    /**
+     * @brief Resolve the pool layout and build options shared by all sessions
+     */
+    PoolLayout ConfigureSessionOptions() {
+        PoolLayout layout = ResolvePoolLayout(pool_size, num_threads, max_concurrent,
+                                              std::thread::hardware_concurrency());
+
+        // Configure for high performance
+        session_options = MakeSessionOptions(layout, GraphOptimizationLevel::ORT_ENABLE_ALL);
+
+        // Prepacked weights are computed by the first session and reused
+        prepacked_weights = std::make_unique<Ort::PrepackedWeightsContainer>();
+        load_stats = LoadStats();
+        return layout;
+    }
+
+    std::unique_ptr<Ort::Session> CreateSession(const std::string& model_path,
+                                                const Ort::SessionOptions& options) {
+        const MappedFile* mapping = use_mmap ? MapModel(model_path) : nullptr;
+        if (mapping) {
+            return std::make_unique<Ort::Session>(*env, mapping->data(), mapping->size(),
+                                                  options, *prepacked_weights);
+        }
+
+        auto path = OrtPath(model_path);
+        return std::make_unique<Ort::Session>(*env, path.c_str(), options, *prepacked_weights);
+    }
+
+    /**
+     * @brief Map a model file once for the pool being built
+     * @return Mapping, or null to fall back to reading the file
+     */
+    const MappedFile* MapModel(const std::string& model_path) {
+        for (const auto& mapping : loading_mappings) {
+            if (mapping->path() == model_path) {
+                return mapping.get();
+            }
+        }
+
+        auto mapping = std::make_unique<MappedFile>();
+        if (!mapping->Open(model_path)) {
+            return nullptr;
+        }
+        loading_mappings.push_back(std::move(mapping));
+        return loading_mappings.back().get();
+    }
+
+    void UnmapModel(const std::string& model_path) {
+        loading_mappings.erase(
+            std::remove_if(loading_mappings.begin(), loading_mappings.end(),
+                           [&](const std::unique_ptr<MappedFile>& mapping) {
+                               return mapping->path() == model_path;
+                           }),
+            loading_mappings.end());
+    }
+
+    // ==========================================
+    // Optimized Model Cache
+    // ==========================================
+
+    /**
+     * @brief Path of the optimized artifact for a model, or empty if disabled
+     *
+     * @details The name is keyed by the model's contents, the ONNX Runtime
+     * version and the CPU features, since ORT_ENABLE_ALL bakes hardware
+     * specific layouts into the graph. GPU sessions are never cached.
+     */
+    std::string OptimizedModelPath(const std::string& model_path) {
+        if (!cache_optimized || use_gpu) {
+            return "";
+        }
+
+        std::string dir = optimized_cache_dir.empty() ?
+                          FileUtils::GetDirectory(model_path) : optimized_cache_dir;
+        if (!optimized_cache_dir.empty() && !FileUtils::CreateDirectories(dir) &&
+            !FileUtils::IsDirectory(dir)) {
+            return "";
+        }
+
+        // Counted against the cache's savings
+        auto hash_start = std::chrono::steady_clock::now();
+        std::string sidecar = FileUtils::JoinPath(dir, FileUtils::GetFilename(model_path) + ".hash");
+        uint64_t model_hash = HashFileCached(model_path, sidecar,
+                                             use_mmap ? MapModel(model_path) : nullptr);
+        hash_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - hash_start);
+        if (model_hash == 0) {
+            return "";
+        }
+
+        std::string key_source = std::to_string(model_hash) + "|" +
+                                 OrtGetApiBase()->GetVersionString() + "|" + CpuFeatureTag();
+        char key[17];
+        std::snprintf(key, sizeof(key), "%016llx",
+                      static_cast<unsigned long long>(Fnv1a(key_source.data(), key_source.size())));
+
+        return FileUtils::JoinPath(dir, FileUtils::GetStem(model_path) + ".opt-" + key + ".ort");
+    }
+
+    /**
+     * @brief Open a previously written artifact with optimization disabled
+     * @return Session, or null if there is no usable artifact
+     */
+    std::unique_ptr<Ort::Session> OpenOptimizedModel(const std::string& artifact,
+                                                     const PoolLayout& layout) {
+        if (!FileUtils::Exists(artifact)) {
+            return nullptr;
+        }
+
+        auto start = std::chrono::steady_clock::now();
         try {
-            // Create session options
-            session_options = std::make_unique<Ort::SessionOptions>();
+            auto options = MakeSessionOptions(layout, GraphOptimizationLevel::ORT_DISABLE_ALL, true);
+            auto session = CreateSession(artifact, *options);
+            auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start);
+
+            // The sidecar records how long optimizing the source model took;
+            // without the cache every session of the pool would pay it.
+            // Opening the artifact and hashing the model are the cache's
+            // own cost, so a slow artifact load reports no savings.
+            long long optimize_ms = std::atoll(FileUtils::ReadTextFile(artifact + ".ms").c_str());
+            long long saved = (optimize_ms - elapsed.count()) *
+                              static_cast<long long>(layout.num_sessions) - hash_time.count();
+            load_stats.time_saved = std::chrono::milliseconds(std::max<long long>(0, saved));
+            return session;
+
+        } catch (const Ort::Exception& e) {
+            // Truncated or written by an incompatible build; rebuild it
+            std::cerr << "Discarding optimized model " << artifact << ": " << e.what() << std::endl;
+            UnmapModel(artifact);
+            FileUtils::DeleteFile(artifact);
+            FileUtils::DeleteFile(artifact + ".ms");
+            return nullptr;
+        }
+    }
 
-            // Configure for high performance
-            session_options->SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_ALL);
+    /**
+     * @brief Optimize the source model and save the result as the artifact
+     * @return Session for the source model (throws if the model cannot load)
+     */
+    std::unique_ptr<Ort::Session> SaveOptimizedModel(const std::string& model_path,
+                                                     const std::string& artifact,
+                                                     const PoolLayout& layout) {
+        // Written under a private name and renamed so that a concurrent
+        // start never opens a partial file
+        std::string temp = artifact + ".tmp" + std::to_string(
+            std::chrono::steady_clock::now().time_since_epoch().count());
+        auto temp_path = OrtPath(temp);
+
+        auto options = MakeSessionOptions(layout, GraphOptimizationLevel::ORT_ENABLE_ALL);
+        options->SetOptimizedModelFilePath(temp_path.c_str());
+        options->AddConfigEntry("session.save_model_format", "ORT");
+
+        auto start = std::chrono::steady_clock::now();
+        auto session = CreateSession(model_path, *options);
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start);
+
+        if (FileUtils::WriteTextFile(artifact + ".ms", std::to_string(elapsed.count())) &&
+            FileUtils::MoveFile(temp, artifact)) {
+            load_stats.optimized_model_path = artifact;
+            load_stats.wrote_optimized_model = true;
+        } else {
+            FileUtils::DeleteFile(temp);
+        }
+        return session;
+    }
 
-            // Set thread count
-            if (num_threads == 0) {
-                // Use all available cores
-                session_options->SetIntraOpNumThreads(0);
-                session_options->SetInterOpNumThreads(0);
+    /**
+     * @brief Create the pool from a session factory and read the model info
+     */
+    template <typename MakeSession>
+    void BuildPool(size_t num_sessions, MakeSession make_session) {
+        std::vector<std::unique_ptr<PooledSession>> created;
+        for (size_t i = 0; i < num_sessions; i++) {
+            auto pooled = std::make_unique<PooledSession>();
+            pooled->session = make_session(i);
+            if (!vocoder_path.empty()) {
+                pooled->vocoder = CreateSession(vocoder_path, *session_options);
+            }
+            created.push_back(std::move(pooled));
+        }
+        // The vocoder was parsed into copies, so its mapping is not needed
+        UnmapModel(vocoder_path);
+
+        std::lock_guard<std::mutex> lock(pool_mutex);
+        sessions = std::move(created);
+        ExtractModelInfo();
+
+        // Bind only the waveform, or for a split model the frame features;
+        // ORT allocates them from the shared arena because their length is
+        // only known once durations are predicted
+        idle_sessions.clear();
+        for (auto& pooled : sessions) {
+            pooled->binding = std::make_unique<Ort::IoBinding>(*pooled->session);
+            if (pooled->vocoder) {
+                for (const char* name : output_names_raw) {
+                    pooled->binding->BindOutput(name, *memory_info);
+                }
+            } else if (magnitude_output >= 0) {
+                pooled->binding->BindOutput(output_names_raw[magnitude_output], *memory_info);
+                pooled->binding->BindOutput(output_names_raw[phase_output], *memory_info);
             } else {
-                session_options->SetIntraOpNumThreads(num_threads);
-                session_options->SetInterOpNumThreads(num_threads);
+                pooled->binding->BindOutput(output_names_raw.front(), *memory_info);
             }
+            pooled->style_buffer.reserve(KOKORO_STYLE_DIM);
+            idle_sessions.push_back(pooled.get());
+        }
+    }
 
-            // Enable parallel execution
-            session_options->SetExecutionMode(ExecutionMode::ORT_PARALLEL);
-
-            // GPU configuration
-            if (use_gpu) {
-                #ifdef USE_CUDA
-                OrtCUDAProviderOptions cuda_options;
-                cuda_options.device_id = 0;
-                cuda_options.arena_extend_strategy = 0;
-                cuda_options.gpu_mem_limit = SIZE_MAX;
-                cuda_options.cudnn_conv_algo_search = OrtCudnnConvAlgoSearch::EXHAUSTIVE;
-                cuda_options.do_copy_in_default_stream = 1;
-
-                session_options->AppendExecutionProvider_CUDA(cuda_options);
-                #endif
-            }
+    bool LoadModel(const std::string& model_path) {
+        try {
+            auto load_start = std::chrono::steady_clock::now();
+            PoolLayout layout = ConfigureSessionOptions();
+            loading_mappings.clear();
+
+            // The first session comes from the optimized cache when possible;
+            // otherwise it optimizes the model and writes the cache
+            std::string source = model_path;
+            const Ort::SessionOptions* options = session_options.get();
+            std::unique_ptr<Ort::SessionOptions> artifact_options;
+            std::unique_ptr<Ort::Session> first;
+
+            std::string artifact = OptimizedModelPath(model_path);
+            if (!artifact.empty()) {
+                first = OpenOptimizedModel(artifact, layout);
+                if (first) {
+                    load_stats.optimized_model_path = artifact;
+                    load_stats.used_optimized_model = true;
+                } else {
+                    first = SaveOptimizedModel(model_path, artifact, layout);
+                }
 
-            // Create session
-            #ifdef _WIN32
-            std::wstring wide_path(model_path.begin(), model_path.end());
-            session = std::make_unique<Ort::Session>(*env, wide_path.c_str(), *session_options);
-            #else
-            session = std::make_unique<Ort::Session>(*env, model_path.c_str(), *session_options);
-            #endif
+                // The rest of the pool skips optimization as well
+                if (FileUtils::Exists(artifact)) {
+                    source = artifact;
+                    artifact_options = MakeSessionOptions(layout, GraphOptimizationLevel::ORT_DISABLE_ALL,
+                                                          true);
+                    options = artifact_options.get();
+                }
+            }
 
-            // Get input and output information
-            ExtractModelInfo();
+            BuildPool(layout.num_sessions, [&](size_t index) {
+                if (index == 0 && first) {
+                    return std::move(first);
+                }
+                return CreateSession(source, *options);
+            });
+            // The source model was parsed into copies, so only the ORT
+            // format artifact has to stay mapped. The previous pool is
+            // gone, so its mappings can go too.
+            UnmapModel(model_path);
+            model_mappings = std::move(loading_mappings);
+            load_stats.load_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - load_start);
+
+            // Weights are shared, so they are counted once for the pool
+            model_bytes = FileBytes(model_path) + FileBytes(vocoder_path);
 
             loaded = true;
+            ProbeBatching();
             return true;
 
         } catch (const Ort::Exception& e) {
@@ -123,40 +706,41 @@ public:
 
     bool LoadModelFromMemory(const void* model_data, size_t model_size) {
         try {
-            // Create session options (same as file loading)
-            session_options = std::make_unique<Ort::SessionOptions>();
-            session_options->SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_ALL);
-
-            if (num_threads == 0) {
-                session_options->SetIntraOpNumThreads(0);
-                session_options->SetInterOpNumThreads(0);
-            } else {
-                session_options->SetIntraOpNumThreads(num_threads);
-                session_options->SetInterOpNumThreads(num_threads);
-            }
-
-            session_options->SetExecutionMode(ExecutionMode::ORT_PARALLEL);
-
-            // Create session from memory
-            session = std::make_unique<Ort::Session>(
-                *env, model_data, model_size, *session_options
-            );
+            PoolLayout layout = ConfigureSessionOptions();
 
-            // Get input and output information
-            ExtractModelInfo();
+            BuildPool(layout.num_sessions, [&](size_t) {
+                return std::make_unique<Ort::Session>(*env, model_data, model_size,
+                                                      *session_options, *prepacked_weights);
+            });
+            model_bytes = model_size + FileBytes(vocoder_path);
 
             loaded = true;
+            ProbeBatching();
             return true;
 
         } catch (const Ort::Exception& e) {
             std::cerr << "ONNX Runtime error: " << e.what() << std::endl;
             loaded = false;
             return false;
+        } catch (const std::exception& e) {
+            std::cerr << "Error loading model: " << e.what() << std::endl;
+            loaded = false;
+            return false;
         }
     }
 
+    static size_t FileBytes(const std::string& path) {
+        if (path.empty()) {
+            return 0;
+        }
+        std::error_code ec;
+        auto file_size = std::filesystem::file_size(path, ec);
+        return ec ? 0 : static_cast<size_t>(file_size);
+    }
+
     void ExtractModelInfo() {
-        if (!session) return;
+        if (sessions.empty()) return;
+        Ort::Session* session = sessions.front()->session.get();
 
         // Get input names and shapes
         size_t num_inputs = session->GetInputCount();
@@ -189,158 +773,788 @@ public:
             auto tensor_info = type_info.GetTensorTypeAndShapeInfo();
             output_shapes.push_back(tensor_info.GetShape());
         }
+
+        // Batching needs a non-singleton batch dimension on the token input
+        // and a duration output to split the padded waveform per row
+        duration_output_index = -1;
+        for (size_t i = 1; i < output_names.size(); i++) {
+            if (output_names[i].find("dur") != std::string::npos) {
+                duration_output_index = static_cast<int>(i);
+                break;
+            }
+        }
+        supports_batching = duration_output_index >= 0 &&
+                            input_shapes.size() >= 3 &&
+                            input_shapes[0].size() == 2 && input_shapes[0][0] != 1 &&
+                            !input_shapes[1].empty() && input_shapes[1][0] != 1;
+
+        // Name arrays passed to every Run call
+        input_names_raw.clear();
+        for (const auto& name : input_names) {
+            input_names_raw.push_back(name.c_str());
+        }
+        output_names_raw.clear();
+        for (const auto& name : output_names) {
+            output_names_raw.push_back(name.c_str());
+        }
+
+        // A split model's acoustic half ends at frame features instead
+        magnitude_output = -1;
+        phase_output = -1;
+        if (!sessions.front()->vocoder &&
+            FindSpectralOutputs(output_names, magnitude_output, phase_output)) {
+            CheckSpectralShape(output_shapes[magnitude_output], output_names[magnitude_output]);
+            CheckSpectralShape(output_shapes[phase_output], output_names[phase_output]);
+            // Rows are trimmed by samples per frame, which assumes a waveform
+            supports_batching = false;
+        }
+
+        ExtractVocoderInfo();
+    }
+
+    /**
+     * @brief Match the vocoder's inputs to the acoustic model's outputs
+     */
+    void ExtractVocoderInfo() {
+        vocoder_inputs.clear();
+        vocoder_input_names_raw.clear();
+        vocoder_output_names.clear();
+        vocoder_output_names_raw.clear();
+        vocoder_spectral = false;
+
+        Ort::Session* vocoder = sessions.front()->vocoder.get();
+        if (!vocoder) {
+            return;
+        }
+
+        bool has_features = false;
+        for (size_t i = 0; i < vocoder->GetInputCount(); i++) {
+            VocoderInput input;
+            input.name = vocoder->GetInputNameAllocated(i, *allocator).get();
+
+            auto match = std::find(output_names.begin(), output_names.end(), input.name);
+            if (match != output_names.end()) {
+                input.feature_output = static_cast<int>(match - output_names.begin());
+                has_features = true;
+            } else {
+                auto shape = vocoder->GetInputTypeInfo(i).GetTensorTypeAndShapeInfo().GetShape();
+                if (shape.size() != 2) {
+                    throw std::runtime_error("Vocoder input '" + input.name +
+                                             "' is neither a model output nor a style vector");
+                }
+                input.style_dim = shape[1];
+            }
+            vocoder_inputs.push_back(std::move(input));
+        }
+        if (!has_features) {
+            throw std::runtime_error("Vocoder takes none of the model's outputs");
+        }
+
+        for (const auto& input : vocoder_inputs) {
+            vocoder_input_names_raw.push_back(input.name.c_str());
+        }
+        std::vector<std::string> names;
+        for (size_t i = 0; i < vocoder->GetOutputCount(); i++) {
+            names.push_back(vocoder->GetOutputNameAllocated(i, *allocator).get());
+        }
+        int magnitude = -1;
+        int phase = -1;
+        vocoder_spectral = FindSpectralOutputs(names, magnitude, phase);
+        if (vocoder_spectral) {
+            CheckSpectralShape(vocoder->GetOutputTypeInfo(magnitude).GetTensorTypeAndShapeInfo().GetShape(),
+                               names[magnitude]);
+            CheckSpectralShape(vocoder->GetOutputTypeInfo(phase).GetTensorTypeAndShapeInfo().GetShape(),
+                               names[phase]);
+            vocoder_output_names = {names[magnitude], names[phase]};
+        } else {
+            vocoder_output_names = {names.front()};
+        }
+        for (const auto& name : vocoder_output_names) {
+            vocoder_output_names_raw.push_back(name.c_str());
+        }
+
+        // Padded rows cannot be windowed separately
+        supports_batching = false;
     }
 
     std::vector<float> RunInference(
         const std::vector<int>& tokens,
         const std::vector<float>& style_vector,
         float speed,
-        float pitch
+        float pitch,
+        CancellationToken* cancel = nullptr
     ) {
-        if (!loaded || !session) {
+        if (!loaded || (cancel && cancel->IsCancelled())) {
+            return {};
+        }
+
+        SessionLease session(*this);
+        return RunOn(*session, tokens, style_vector, speed, pitch, cancel);
+    }
+
+    /**
+     * @brief Run one request on a session the caller has checked out
+     *
+     * @details Inputs are written into the session's persistent buffers
+     * and bound through its IoBinding, so a steady-state call allocates
+     * only the output waveform and the returned sample vector.
+     */
+    std::vector<float> RunOn(
+        PooledSession& pooled,
+        const std::vector<int>& tokens,
+        const std::vector<float>& style_vector,
+        float speed,
+        float pitch,
+        CancellationToken* cancel
+    ) {
+        if (cancel && cancel->IsCancelled()) {
             return {};
         }
 
         auto start = std::chrono::high_resolution_clock::now();
 
         try {
-            // Prepare input tensors
-            std::vector<Ort::Value> input_tensors;
+            RunBound(pooled, tokens, style_vector, speed, pitch, cancel);
 
-            // 1. Tokens tensor (shape: [1, sequence_length])
-            std::vector<int64_t> token_shape = {1, static_cast<int64_t>(tokens.size())};
-            std::vector<int64_t> token_data(tokens.begin(), tokens.end());
-
-            input_tensors.push_back(
-                Ort::Value::CreateTensor<int64_t>(
-                    *memory_info,
-                    token_data.data(),
-                    token_data.size(),
-                    token_shape.data(),
-                    token_shape.size()
-                )
-            );
+            // Extract audio samples from output
+            auto output_tensors = pooled.binding->GetOutputValues();
+            std::vector<float> audio_samples;
+            if (pooled.vocoder) {
+                bool complete = VocodeWindows(pooled, output_tensors, style_vector, 0, cancel,
+                    [&audio_samples](std::vector<float> samples, bool) {
+                        audio_samples = std::move(samples);
+                    });
+                if (!complete) {
+                    return {};
+                }
+            } else if (magnitude_output >= 0) {
+                // Bound as magnitude, phase
+                audio_samples = SpectrogramToAudio(pooled, output_tensors[0], output_tensors[1]);
+            } else if (!output_tensors.empty()) {
+                const auto& audio_tensor = output_tensors[0];
+                const float* audio_data = audio_tensor.GetTensorData<float>();
+                size_t total_size = audio_tensor.GetTensorTypeAndShapeInfo().GetElementCount();
+
+                // The one copy, into the vector that becomes the result's audio
+                audio_samples.assign(audio_data, audio_data + total_size);
+            } else {
+                return {};
+            }
 
-            // 2. Style vector tensor (shape: [1, style_dim])
-            std::vector<int64_t> style_shape = {1, static_cast<int64_t>(style_vector.size())};
-            auto style_data = style_vector;  // Copy to ensure contiguous memory
-
-            input_tensors.push_back(
-                Ort::Value::CreateTensor<float>(
-                    *memory_info,
-                    style_data.data(),
-                    style_data.size(),
-                    style_shape.data(),
-                    style_shape.size()
-                )
-            );
+            NoteTensorBytes(tokens.size() * sizeof(int64_t) +
+                            style_vector.size() * sizeof(float) +
+                            audio_samples.size() * sizeof(float));
+            RecordLatency(start);
+            return audio_samples;
 
-            // 3. Speed tensor (shape: [1])
-            std::vector<float> speed_data = {speed};
-            std::vector<int64_t> speed_shape = {1};
-
-            input_tensors.push_back(
-                Ort::Value::CreateTensor<float>(
-                    *memory_info,
-                    speed_data.data(),
-                    speed_data.size(),
-                    speed_shape.data(),
-                    speed_shape.size()
-                )
-            );
+        } catch (const Ort::Exception& e) {
+            if (!cancel || !cancel->IsCancelled()) {
+                std::cerr << "ONNX Runtime inference error: " << e.what() << std::endl;
+            }
+        }
 
-            // If model expects pitch (4th input)
-            if (input_names.size() > 3) {
-                std::vector<float> pitch_data = {pitch};
-                std::vector<int64_t> pitch_shape = {1};
-
-                input_tensors.push_back(
-                    Ort::Value::CreateTensor<float>(
-                        *memory_info,
-                        pitch_data.data(),
-                        pitch_data.size(),
-                        pitch_shape.data(),
-                        pitch_shape.size()
-                    )
-                );
+        return {};
+    }
+
+    bool RunStreamingInference(
+        const std::vector<int>& tokens,
+        const std::vector<float>& style_vector,
+        float speed,
+        float pitch,
+        const AudioWindowCallback& on_audio,
+        CancellationToken* cancel
+    ) {
+        if (!loaded || (cancel && cancel->IsCancelled())) {
+            return false;
+        }
+
+        SessionLease session(*this);
+        if (!session->vocoder) {
+            std::vector<float> audio = RunOn(*session, tokens, style_vector, speed, pitch, cancel);
+            if (audio.empty()) {
+                return false;
             }
+            on_audio(std::move(audio), true);
+            return true;
+        }
+
+        auto start = std::chrono::high_resolution_clock::now();
 
-            // Prepare input/output names
-            std::vector<const char*> input_names_raw;
-            for (const auto& name : input_names) {
-                input_names_raw.push_back(name.c_str());
+        try {
+            RunBound(*session, tokens, style_vector, speed, pitch, cancel);
+            auto output_tensors = session->binding->GetOutputValues();
+            if (!VocodeWindows(*session, output_tensors, style_vector, vocoder_window_frames,
+                               cancel, on_audio)) {
+                return false;
             }
+            RecordLatency(start);
+            return true;
 
-            std::vector<const char*> output_names_raw;
-            for (const auto& name : output_names) {
-                output_names_raw.push_back(name.c_str());
+        } catch (const Ort::Exception& e) {
+            if (!cancel || !cancel->IsCancelled()) {
+                std::cerr << "ONNX Runtime inference error: " << e.what() << std::endl;
             }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Bind one request's inputs and run the model on its binding
+     *
+     * @details Outputs stay in the binding: the waveform, or for a split
+     * model the frame features. Throws Ort::Exception on failure.
+     */
+    void RunBound(
+        PooledSession& pooled,
+        const std::vector<int>& tokens,
+        const std::vector<float>& style_vector,
+        float speed,
+        float pitch,
+        CancellationToken* cancel
+    ) {
+        // Prepare input tensors over the reused buffers
+        JP_TRACE_BEGIN(tensor_build);
+        pooled.token_buffer.assign(tokens.begin(), tokens.end());
+        pooled.style_buffer.assign(style_vector.begin(), style_vector.end());
+        pooled.speed = speed;
+        pooled.pitch = pitch;
+
+        const int64_t token_shape[] = {1, static_cast<int64_t>(tokens.size())};
+        const int64_t style_shape[] = {1, static_cast<int64_t>(style_vector.size())};
+        const int64_t scalar_shape[] = {1};
+
+        // 1. Tokens [1, sequence_length], 2. style [1, style_dim], 3. speed [1]
+        Ort::Value token_tensor = Ort::Value::CreateTensor<int64_t>(
+            *memory_info, pooled.token_buffer.data(), pooled.token_buffer.size(),
+            token_shape, 2);
+        Ort::Value style_tensor = Ort::Value::CreateTensor<float>(
+            *memory_info, pooled.style_buffer.data(), pooled.style_buffer.size(),
+            style_shape, 2);
+        Ort::Value speed_tensor = Ort::Value::CreateTensor<float>(
+            *memory_info, &pooled.speed, 1, scalar_shape, 1);
+
+        Ort::IoBinding& binding = *pooled.binding;
+        binding.BindInput(input_names_raw[0], token_tensor);
+        binding.BindInput(input_names_raw[1], style_tensor);
+        binding.BindInput(input_names_raw[2], speed_tensor);
+
+        // If model expects pitch (4th input)
+        Ort::Value pitch_tensor{nullptr};
+        if (input_names_raw.size() > 3) {
+            pitch_tensor = Ort::Value::CreateTensor<float>(
+                *memory_info, &pooled.pitch, 1, scalar_shape, 1);
+            binding.BindInput(input_names_raw[3], pitch_tensor);
+        }
+
+        JP_TRACE_END(tensor_build, "tensor_build");
+
+        // Run inference; cancellation terminates the run from the cancelling thread
+        Ort::RunOptions run_options = MakeRunOptions();
+        CancellationRegistration abort_run(cancel, [&run_options]() {
+            run_options.SetTerminate();
+        });
 
-            // Run inference
-            auto output_tensors = session->Run(
-                Ort::RunOptions{nullptr},
+        JP_TRACE_BEGIN(session_run);
+        pooled.session->Run(run_options, binding);
+        JP_TRACE_END(session_run, "session_run");
+    }
+
+    // ==========================================
+    // Windowed Vocoder
+    // ==========================================
+
+    /**
+     * @brief Run the vocoder over overlapping windows of frame features
+     *
+     * @details Each window is widened by the context frames on both sides
+     * so the vocoder's receptive field sees real neighbours at its edges.
+     * The context audio is dropped, except for one frame after the window
+     * that is crossfaded into the start of the next one to hide any
+     * remaining seam.
+     *
+     * @param features Acoustic model outputs, in output_names order
+     * @param window_frames Frames delivered per window (0 = all at once)
+     * @return false if the run was cancelled or produced no audio
+     */
+    bool VocodeWindows(PooledSession& pooled,
+                       const std::vector<Ort::Value>& features,
+                       const std::vector<float>& style_vector,
+                       size_t window_frames,
+                       CancellationToken* cancel,
+                       const AudioWindowCallback& on_audio) {
+        // Features may run at a multiple of the frame rate (F0 and energy
+        // are predicted at twice the rate of the aligned text features)
+        std::vector<std::vector<int64_t>> shapes(vocoder_inputs.size());
+        int64_t total_frames = 0;
+        for (size_t i = 0; i < vocoder_inputs.size(); i++) {
+            if (vocoder_inputs[i].feature_output < 0) {
+                continue;
+            }
+            shapes[i] = features[vocoder_inputs[i].feature_output].GetTensorTypeAndShapeInfo().GetShape();
+            if (shapes[i].empty()) {
+                return false;
+            }
+            int64_t length = shapes[i].back();
+            total_frames = total_frames == 0 ? length : std::min(total_frames, length);
+        }
+        if (total_frames <= 0) {
+            return false;
+        }
+        for (const auto& shape : shapes) {
+            if (!shape.empty() && shape.back() % total_frames != 0) {
+                std::cerr << "Vocoder features are not whole multiples of the frame count" << std::endl;
+                return false;
+            }
+        }
+
+        size_t frames = static_cast<size_t>(total_frames);
+        if (window_frames == 0 || window_frames > frames) {
+            window_frames = frames;
+        }
+
+        std::vector<std::vector<float>> slices(vocoder_inputs.size());
+        std::vector<float> tail;  // Previous window's audio just past its end
+
+        for (size_t begin = 0; begin < frames; begin += window_frames) {
+            if (cancel && cancel->IsCancelled()) {
+                return false;
+            }
+
+            size_t end = std::min(frames, begin + window_frames);
+            size_t from = begin > vocoder_context_frames ? begin - vocoder_context_frames : 0;
+            size_t to = std::min(frames, end + vocoder_context_frames);
+
+            std::vector<Ort::Value> inputs;
+            for (size_t i = 0; i < vocoder_inputs.size(); i++) {
+                const VocoderInput& input = vocoder_inputs[i];
+                if (input.feature_output < 0) {
+                    size_t count = style_vector.size();
+                    if (input.style_dim > 0) {
+                        count = std::min(count, static_cast<size_t>(input.style_dim));
+                    }
+                    slices[i].assign(style_vector.begin(), style_vector.begin() + count);
+                    const int64_t style_shape[] = {1, static_cast<int64_t>(count)};
+                    inputs.push_back(Ort::Value::CreateTensor<float>(
+                        *memory_info, slices[i].data(), count, style_shape, 2));
+                    continue;
+                }
+
+                // Copy the window out of every row along the time axis
+                const Ort::Value& feature = features[input.feature_output];
+                std::vector<int64_t> shape = shapes[i];
+                size_t length = static_cast<size_t>(shape.back());
+                size_t rate = length / frames;
+                size_t rows = feature.GetTensorTypeAndShapeInfo().GetElementCount() / length;
+                const float* data = feature.GetTensorData<float>();
+
+                std::vector<float>& slice = slices[i];
+                slice.resize(rows * (to - from) * rate);
+                for (size_t row = 0; row < rows; row++) {
+                    std::copy(data + row * length + from * rate, data + row * length + to * rate,
+                              slice.begin() + row * (to - from) * rate);
+                }
+                shape.back() = static_cast<int64_t>((to - from) * rate);
+                inputs.push_back(Ort::Value::CreateTensor<float>(
+                    *memory_info, slice.data(), slice.size(), shape.data(), shape.size()));
+            }
+
+            Ort::RunOptions run_options = MakeRunOptions();
+            CancellationRegistration abort_run(cancel, [&run_options]() {
+                run_options.SetTerminate();
+            });
+
+            JP_TRACE_BEGIN(vocoder_run);
+            auto outputs = pooled.vocoder->Run(run_options, vocoder_input_names_raw.data(),
+                                               inputs.data(), inputs.size(),
+                                               vocoder_output_names_raw.data(),
+                                               vocoder_output_names_raw.size());
+            JP_TRACE_END(vocoder_run, "vocoder_run");
+
+            std::vector<float> spectral_audio;
+            const float* audio;
+            size_t audio_size;
+            if (vocoder_spectral) {
+                spectral_audio = SpectrogramToAudio(pooled, outputs[0], outputs[1]);
+                audio = spectral_audio.data();
+                audio_size = spectral_audio.size();
+            } else {
+                audio = outputs[0].GetTensorData<float>();
+                audio_size = outputs[0].GetTensorTypeAndShapeInfo().GetElementCount();
+            }
+            size_t samples_per_frame = audio_size / (to - from);
+            if (samples_per_frame == 0) {
+                return false;
+            }
+
+            // Keep this window's own frames; the last one keeps the remainder
+            size_t keep_begin = (begin - from) * samples_per_frame;
+            size_t keep_end = end == to ? audio_size : (end - from) * samples_per_frame;
+            std::vector<float> window(audio + keep_begin, audio + keep_end);
+
+            for (size_t i = 0; i < tail.size() && i < window.size(); i++) {
+                float weight = static_cast<float>(i + 1) / static_cast<float>(tail.size() + 1);
+                window[i] = tail[i] * (1.0f - weight) + window[i] * weight;
+            }
+            size_t tail_end = std::min(audio_size, keep_end + samples_per_frame);
+            tail.assign(audio + keep_end, audio + tail_end);
+
+            on_audio(std::move(window), end == frames);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Finish a [1, bins, frames] magnitude/phase pair into a waveform
+     */
+    static std::vector<float> SpectrogramToAudio(PooledSession& pooled,
+                                                 const Ort::Value& magnitude,
+                                                 const Ort::Value& phase) {
+        JP_TRACE_SCOPE("istft");
+        size_t frames = static_cast<size_t>(magnitude.GetTensorTypeAndShapeInfo().GetShape().back());
+        return pooled.istft.Transform(magnitude.GetTensorData<float>(),
+                                      phase.GetTensorData<float>(), frames);
+    }
+
+    void RecordLatency(std::chrono::high_resolution_clock::time_point start) {
+        auto end = std::chrono::high_resolution_clock::now();
+        double latency_ms = std::chrono::duration_cast<std::chrono::microseconds>(
+            end - start).count() / 1000.0;
+
+        std::lock_guard<std::mutex> lock(stats_mutex);
+        total_inferences++;
+        total_latency_ms += latency_ms;
+        min_latency_ms = std::min(min_latency_ms, latency_ms);
+        max_latency_ms = std::max(max_latency_ms, latency_ms);
+    }
+
+    /**
+     * @brief Turn batching off unless stacked rows come out as they do alone
+     *
+     * @details Compares sample counts, which follow the predicted
+     * durations; the generator's noise source keeps the samples
+     * themselves from being bit-comparable between runs.
+     */
+    void ProbeBatching() {
+        if (!supports_batching) {
+            return;
+        }
+
+        constexpr size_t kProbeTokens = 8;
+        std::vector<std::vector<int>> rows(2, std::vector<int>(kProbeTokens));
+        for (size_t i = 0; i < kProbeTokens; i++) {
+            rows[0][i] = static_cast<int>(1 + i);
+            rows[1][i] = static_cast<int>(1 + (i * 5) % 16);
+        }
+        std::vector<std::vector<float>> styles(rows.size(), std::vector<float>(StyleDim(), 0.5f));
+        std::vector<float> speeds(rows.size(), 1.0f);
+
+        SessionLease session(*this);
+        auto stacked = RunStacked(*session, rows, styles, speeds);
+        auto alone = RunSequential(*session, rows, styles, speeds);
+        for (size_t b = 0; b < rows.size(); b++) {
+            if (alone[b].empty() || stacked[b].size() != alone[b].size()) {
+                std::cerr << "Batched rows do not match single runs; batching disabled" << std::endl;
+                supports_batching = false;
+                return;
+            }
+        }
+    }
+
+    std::vector<std::vector<float>> RunBatchInference(
+        const std::vector<std::vector<int>>& batch_tokens,
+        const std::vector<std::vector<float>>& style_vectors,
+        const std::vector<float>& speeds
+    ) {
+        const size_t batch_size = batch_tokens.size();
+        if (!loaded || batch_size == 0) {
+            return std::vector<std::vector<float>>(batch_size);
+        }
+
+        SessionLease session(*this);
+
+        if (batch_size == 1 || !supports_batching || style_vectors.size() != batch_size) {
+            return RunSequential(*session, batch_tokens, style_vectors, speeds);
+        }
+
+        // The export takes no length or mask input, so the text encoder and
+        // duration predictor would read pad tokens; only rows of identical
+        // length share a call
+        std::map<size_t, std::vector<size_t>> by_length;
+        for (size_t b = 0; b < batch_size; b++) {
+            by_length[batch_tokens[b].size()].push_back(b);
+        }
+
+        std::vector<std::vector<float>> results(batch_size);
+        for (const auto& group : by_length) {
+            std::vector<std::vector<int>> group_tokens;
+            std::vector<std::vector<float>> group_styles;
+            std::vector<float> group_speeds;
+            for (size_t b : group.second) {
+                group_tokens.push_back(batch_tokens[b]);
+                group_styles.push_back(style_vectors[b]);
+                group_speeds.push_back(b < speeds.size() ? speeds[b] : 1.0f);
+            }
+
+            auto outputs = group_tokens.size() == 1 ?
+                RunSequential(*session, group_tokens, group_styles, group_speeds) :
+                RunStacked(*session, group_tokens, group_styles, group_speeds);
+            for (size_t i = 0; i < group.second.size(); i++) {
+                results[group.second[i]] = std::move(outputs[i]);
+            }
+        }
+        return results;
+    }
+
+    /**
+     * @brief Run rows of equal token length as one [B, L] call
+     *
+     * @note supports_batching must be true, which also guarantees the
+     *       speed input exists
+     */
+    std::vector<std::vector<float>> RunStacked(
+        PooledSession& pooled,
+        const std::vector<std::vector<int>>& batch_tokens,
+        const std::vector<std::vector<float>>& style_vectors,
+        const std::vector<float>& speeds
+    ) {
+        const size_t batch_size = batch_tokens.size();
+
+        // A fixed [1] speed input can only be shared by the whole batch
+        bool per_row_speed = input_shapes[2].empty() || input_shapes[2][0] != 1;
+        bool uniform_speed = std::all_of(speeds.begin(), speeds.end(),
+            [&](float s) { return s == speeds.front(); });
+        if (!per_row_speed && !uniform_speed) {
+            return RunSequential(pooled, batch_tokens, style_vectors, speeds);
+        }
+
+        auto start = std::chrono::high_resolution_clock::now();
+
+        try {
+            size_t max_len = 0;
+            for (const auto& tokens : batch_tokens) {
+                max_len = std::max(max_len, tokens.size());
+            }
+            size_t style_dim = style_vectors.front().size();
+
+            // Stack tokens into [B, L] and styles into [B, style_dim]
+            JP_TRACE_BEGIN(tensor_build);
+            std::vector<int64_t> token_data(batch_size * max_len, KOKORO_PAD_TOKEN);
+            std::vector<float> style_data(batch_size * style_dim, 0.0f);
+            std::vector<float> speed_data(per_row_speed ? batch_size : 1, 1.0f);
+
+            for (size_t b = 0; b < batch_size; b++) {
+                std::copy(batch_tokens[b].begin(), batch_tokens[b].end(),
+                          token_data.begin() + b * max_len);
+                std::copy_n(style_vectors[b].begin(),
+                            std::min(style_dim, style_vectors[b].size()),
+                            style_data.begin() + b * style_dim);
+                if (b < speed_data.size()) {
+                    speed_data[b] = b < speeds.size() ? speeds[b] : 1.0f;
+                }
+            }
+
+            std::vector<int64_t> token_shape = {static_cast<int64_t>(batch_size),
+                                                static_cast<int64_t>(max_len)};
+            std::vector<int64_t> style_shape = {static_cast<int64_t>(batch_size),
+                                                static_cast<int64_t>(style_dim)};
+            std::vector<int64_t> speed_shape = {static_cast<int64_t>(speed_data.size())};
+
+            std::vector<Ort::Value> input_tensors;
+            input_tensors.push_back(Ort::Value::CreateTensor<int64_t>(
+                *memory_info, token_data.data(), token_data.size(),
+                token_shape.data(), token_shape.size()));
+            input_tensors.push_back(Ort::Value::CreateTensor<float>(
+                *memory_info, style_data.data(), style_data.size(),
+                style_shape.data(), style_shape.size()));
+            input_tensors.push_back(Ort::Value::CreateTensor<float>(
+                *memory_info, speed_data.data(), speed_data.size(),
+                speed_shape.data(), speed_shape.size()));
+
+            std::vector<float> pitch_data(speed_data.size(), 1.0f);
+            if (input_names.size() > 3) {
+                input_tensors.push_back(Ort::Value::CreateTensor<float>(
+                    *memory_info, pitch_data.data(), pitch_data.size(),
+                    speed_shape.data(), speed_shape.size()));
+            }
+
+            JP_TRACE_END(tensor_build, "tensor_build");
+
+            JP_TRACE_BEGIN(session_run);
+            auto output_tensors = pooled.session->Run(
+                MakeRunOptions(),
                 input_names_raw.data(),
                 input_tensors.data(),
                 input_tensors.size(),
                 output_names_raw.data(),
                 output_names_raw.size()
             );
+            JP_TRACE_END(session_run, "session_run");
 
-            // Extract audio samples from output
-            if (!output_tensors.empty()) {
-                auto& audio_tensor = output_tensors[0];
-                float* audio_data = audio_tensor.GetTensorMutableData<float>();
+            auto& audio_tensor = output_tensors[0];
+            auto audio_shape = audio_tensor.GetTensorTypeAndShapeInfo().GetShape();
+            auto& duration_tensor = output_tensors[duration_output_index];
+            auto duration_shape = duration_tensor.GetTensorTypeAndShapeInfo().GetShape();
 
-                auto shape_info = audio_tensor.GetTensorTypeAndShapeInfo();
-                auto shape = shape_info.GetShape();
+            if (audio_shape.size() != 2 || audio_shape[0] != static_cast<int64_t>(batch_size) ||
+                duration_shape.size() != 2 || duration_shape[0] != static_cast<int64_t>(batch_size)) {
+                // Export collapsed the batch dimension; results are not separable
+                return RunSequential(pooled, batch_tokens, style_vectors, speeds);
+            }
 
-                // Calculate total size
-                size_t total_size = 1;
-                for (auto dim : shape) {
-                    total_size *= dim;
+            const float* audio_data = audio_tensor.GetTensorData<float>();
+            const size_t row_samples = static_cast<size_t>(audio_shape[1]);
+            const size_t duration_cols = static_cast<size_t>(duration_shape[1]);
+
+            NoteTensorBytes(batch_size * (max_len * sizeof(int64_t) +
+                                          style_dim * sizeof(float) +
+                                          row_samples * sizeof(float)));
+
+            std::vector<std::vector<float>> results(batch_size);
+            for (size_t b = 0; b < batch_size; b++) {
+                // Rows are padded to the longest waveform in the batch; the
+                // row's own audio is the prefix covered by its durations
+                int64_t frames = 0;
+                size_t valid = std::min(batch_tokens[b].size(), duration_cols);
+                for (size_t t = 0; t < valid; t++) {
+                    frames += DurationAt(duration_tensor, b * duration_cols + t);
                 }
+                size_t samples = std::min(row_samples,
+                    static_cast<size_t>(frames) * KOKORO_SAMPLES_PER_FRAME);
+                const float* row = audio_data + b * row_samples;
+                results[b].assign(row, row + samples);
+            }
 
-                // Copy audio samples
-                std::vector<float> audio_samples(audio_data, audio_data + total_size);
+            RecordLatency(start);
+            return results;
 
-                // Update statistics
-                auto end = std::chrono::high_resolution_clock::now();
-                auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
-                double latency_ms = duration.count() / 1000.0;
+        } catch (const Ort::Exception& e) {
+            std::cerr << "ONNX Runtime batch inference error: " << e.what() << std::endl;
+        }
 
-                {
-                    std::lock_guard<std::mutex> lock(stats_mutex);
-                    total_inferences++;
-                    total_latency_ms += latency_ms;
-                    min_latency_ms = std::min(min_latency_ms, latency_ms);
-                    max_latency_ms = std::max(max_latency_ms, latency_ms);
-                }
+        return RunSequential(pooled, batch_tokens, style_vectors, speeds);
+    }
 
-                return audio_samples;
+    std::vector<std::vector<float>> RunSequential(
+        PooledSession& session,
+        const std::vector<std::vector<int>>& batch_tokens,
+        const std::vector<std::vector<float>>& style_vectors,
+        const std::vector<float>& speeds
+    ) {
+        std::vector<std::vector<float>> results;
+        results.reserve(batch_tokens.size());
+        for (size_t i = 0; i < batch_tokens.size(); i++) {
+            float speed = (i < speeds.size()) ? speeds[i] : 1.0f;
+            results.push_back(RunOn(session, batch_tokens[i], style_vectors[i], speed, 1.0f, nullptr));
+        }
+        return results;
+    }
+
+    /**
+     * @brief Run options for the next call, requesting an arena shrink if pending
+     */
+    Ort::RunOptions MakeRunOptions() {
+        Ort::RunOptions run_options;
+        if (shrink_pending.exchange(false)) {
+            // Frees arena chunks that are unused when this run completes
+            run_options.AddConfigEntry("memory.enable_memory_arena_shrinkage",
+                                       use_gpu ? "cpu:0;gpu:0" : "cpu:0");
+            peak_tensor_bytes = 0;
+        }
+        return run_options;
+    }
+
+    /**
+     * @brief Bytes the CPU arena holds, as reported by ONNX Runtime
+     *
+     * @details Sessions allocate from the environment's shared arena, so
+     * this is the same figure for every SessionManager in the process.
+     *
+     * @return false if no session is loaded or the allocator keeps no stats
+     */
+    bool MeasureArena(size_t& bytes) const {
+        if (sessions.empty()) {
+            return false;
+        }
+        try {
+            Ort::Allocator arena(*sessions.front()->session,
+                Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault));
+            Ort::KeyValuePairs stats = arena.GetStats();
+            // Reserved chunks, in use or not; shrinking lowers it
+            const char* total = stats.GetValue("TotalAllocated");
+            if (!total) {
+                return false;
             }
+            bytes = static_cast<size_t>(std::stoull(total));
+            return true;
+        } catch (const std::exception&) {
+            return false;
+        }
+    }
 
-        } catch (const Ort::Exception& e) {
-            std::cerr << "ONNX Runtime inference error: " << e.what() << std::endl;
+    void NoteTensorBytes(size_t bytes) {
+        size_t peak = peak_tensor_bytes.load();
+        while (bytes > peak && !peak_tensor_bytes.compare_exchange_weak(peak, bytes)) {
         }
+    }
 
-        return {};
+    static int64_t DurationAt(const Ort::Value& tensor, size_t index) {
+        // Exports disagree on the duration dtype
+        auto type = tensor.GetTensorTypeAndShapeInfo().GetElementType();
+        if (type == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT) {
+            return static_cast<int64_t>(std::lround(tensor.GetTensorData<float>()[index]));
+        }
+        if (type == ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32) {
+            return tensor.GetTensorData<int32_t>()[index];
+        }
+        return tensor.GetTensorData<int64_t>()[index];
     }
 
-    void Warmup() {
-        if (!loaded) return;
+    size_t StyleDim() const {
+        if (input_shapes.size() > 1 && !input_shapes[1].empty() && input_shapes[1].back() > 0) {
+            return static_cast<size_t>(input_shapes[1].back());
+        }
+        return KOKORO_STYLE_DIM;
+    }
 
-        // Create dummy input for warmup
-        std::vector<int> dummy_tokens(10, 1);  // 10 tokens
-        std::vector<float> dummy_style(128, 0.5f);  // 128-dim style vector
+    bool Warmup(const std::vector<size_t>& token_lengths) {
+        if (!loaded) return false;
+
+        // Create dummy input for warmup, as wide as the model's style input
+        std::vector<float> dummy_style(StyleDim(), 0.5f);
+        bool succeeded = true;
+
+        // One run per shape on every pooled session so each gets its
+        // kernels and arena blocks. Sessions are warmed one at a time as
+        // they become idle, so live traffic keeps the rest of the pool and
+        // concurrent warmups cannot deadlock holding parts of it.
+        size_t pool_count;
+        {
+            std::lock_guard<std::mutex> lock(pool_mutex);
+            pool_count = sessions.size();
+        }
+        std::vector<PooledSession*> warmed;
+        for (size_t i = 0; i < pool_count; i++) {
+            SessionLease session(*this, warmed);
+            warmed.push_back(&*session);
+            for (size_t length : token_lengths) {
+                std::vector<int> dummy_tokens(std::max<size_t>(1, length), 1);
+                if (RunOn(*session, dummy_tokens, dummy_style, 1.0f, 1.0f, nullptr).empty()) {
+                    succeeded = false;
+                }
+            }
+        }
 
-        // Run warmup inference
-        RunInference(dummy_tokens, dummy_style, 1.0f, 1.0f);
+        if (!succeeded) {
+            std::cerr << "Warmup failed; the model rejected the warmup input" << std::endl;
+        }
 
         // Reset statistics after warmup
+        std::lock_guard<std::mutex> lock(stats_mutex);
         total_inferences = 0;
         total_latency_ms = 0;
         min_latency_ms = std::numeric_limits<double>::max();
         max_latency_ms = 0;
+        return succeeded;
     }
 };
 
@@ -369,9 +1583,10 @@ std::vector<float> SessionManager::RunInference(
     const std::vector<int>& tokens,
     const std::vector<float>& style_vector,
     float speed,
-    float pitch
+    float pitch,
+    CancellationToken* cancel
 ) {
-    return pImpl->RunInference(tokens, style_vector, speed, pitch);
+    return pImpl->RunInference(tokens, style_vector, speed, pitch, cancel);
 }
 
 std::vector<std::vector<float>> SessionManager::RunBatchInference(
@@ -379,17 +1594,30 @@ std::vector<std::vector<float>> SessionManager::RunBatchInference(
     const std::vector<std::vector<float>>& style_vectors,
     const std::vector<float>& speeds
 ) {
-    std::vector<std::vector<float>> results;
+    return pImpl->RunBatchInference(batch_tokens, style_vectors, speeds);
+}
 
-    // For now, process sequentially
-    // TODO: Implement true batch processing if model supports it
-    for (size_t i = 0; i < batch_tokens.size(); i++) {
-        float speed = (i < speeds.size()) ? speeds[i] : 1.0f;
-        auto audio = RunInference(batch_tokens[i], style_vectors[i], speed, 1.0f);
-        results.push_back(audio);
-    }
+bool SessionManager::RunStreamingInference(
+    const std::vector<int>& tokens,
+    const std::vector<float>& style_vector,
+    float speed,
+    float pitch,
+    const AudioWindowCallback& on_audio,
+    CancellationToken* cancel
+) {
+    return pImpl->RunStreamingInference(tokens, style_vector, speed, pitch, on_audio, cancel);
+}
+
+bool SessionManager::HasVocoder() const {
+    return !pImpl->vocoder_inputs.empty();
+}
+
+size_t SessionManager::GetStyleDim() const {
+    return pImpl->StyleDim();
+}
 
-    return results;
+bool SessionManager::SupportsBatching() const {
+    return pImpl->supports_batching;
 }
 
 std::vector<std::pair<std::string, std::vector<int64_t>>> SessionManager::GetInputInfo() const {
@@ -416,6 +1644,46 @@ void SessionManager::SetUseGPU(bool enable) {
     pImpl->use_gpu = enable;
 }
 
+void SessionManager::SetInterOpThreads(int num_threads) {
+    pImpl->inter_op_threads = num_threads;
+}
+
+void SessionManager::SetOptimizedModelCache(bool enable, const std::string& directory) {
+    pImpl->cache_optimized = enable;
+    pImpl->optimized_cache_dir = directory;
+}
+
+SessionManager::LoadStats SessionManager::GetLoadStats() const {
+    return pImpl->load_stats;
+}
+
+void SessionManager::SetVocoderModel(const std::string& vocoder_path) {
+    pImpl->vocoder_path = vocoder_path;
+}
+
+void SessionManager::SetVocoderWindow(size_t window_frames, size_t context_frames) {
+    pImpl->vocoder_window_frames = window_frames;
+    pImpl->vocoder_context_frames = context_frames;
+}
+
+void SessionManager::SetMemoryMapping(bool enable) {
+    pImpl->use_mmap = enable;
+}
+
+void SessionManager::SetAllowSpinning(bool enable) {
+    pImpl->allow_spinning = enable;
+}
+
+void SessionManager::SetPoolSize(size_t num_sessions, size_t max_concurrent) {
+    pImpl->pool_size = num_sessions;
+    pImpl->max_concurrent = std::max<size_t>(1, max_concurrent);
+}
+
+size_t SessionManager::GetPoolSize() const {
+    std::lock_guard<std::mutex> lock(pImpl->pool_mutex);
+    return pImpl->sessions.size();
+}
+
 SessionManager::SessionStats SessionManager::GetStats() const {
     std::lock_guard<std::mutex> lock(pImpl->stats_mutex);
 
@@ -426,7 +1694,13 @@ SessionManager::SessionStats SessionManager::GetStats() const {
     stats.min_latency_ms = (pImpl->total_inferences > 0) ?
                            pImpl->min_latency_ms : 0;
     stats.max_latency_ms = pImpl->max_latency_ms;
-    stats.memory_usage_bytes = 0;  // TODO: Implement memory tracking
+    stats.model_bytes = pImpl->model_bytes;
+    stats.arena_measured = pImpl->MeasureArena(stats.arena_bytes);
+    if (!stats.arena_measured) {
+        // Lower bound only; activations are not visible here
+        stats.arena_bytes = pImpl->peak_tensor_bytes.load();
+    }
+    stats.memory_usage_bytes = stats.model_bytes + stats.arena_bytes;
 
     return stats;
 }
@@ -439,8 +1713,12 @@ void SessionManager::ResetStats() {
     pImpl->max_latency_ms = 0;
 }
 
-void SessionManager::Warmup() {
-    pImpl->Warmup();
+void SessionManager::ShrinkArena() {
+    pImpl->shrink_pending = true;
+}
+
+bool SessionManager::Warmup(const std::vector<size_t>& token_lengths) {
+    return pImpl->Warmup(token_lengths);
 }
 
 } // namespace jp_edge_tts
\ No newline at end of file
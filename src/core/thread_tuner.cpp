@@ -0,0 +1,275 @@
+/**
+ * @file thread_tuner.cpp
+ * @brief Implementation of the ONNX Runtime thread layout tuner
+ * @author D Everett Hinton
+ * @date 2025
+ *
+ * @copyright MIT License
+ */
+
+#include "jp_edge_tts/core/thread_tuner.h"
+#include "jp_edge_tts/core/session_manager.h"
+#include "jp_edge_tts/utils/file_utils.h"
+#include "jp_edge_tts/utils/latency_histogram.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+using json = nlohmann::json;
+
+namespace jp_edge_tts {
+
+ThreadTuner::ThreadTuner(Options options) : options(std::move(options)) {
+    if (this->options.token_pattern.empty()) {
+        this->options.token_pattern.push_back(1);
+    }
+}
+
+// ==========================================
+// Candidates and Selection
+// ==========================================
+
+std::vector<ThreadProfile> ThreadTuner::Candidates(unsigned int cores) {
+    cores = std::max(1u, cores);
+    std::vector<ThreadProfile> candidates;
+
+    auto add = [&](size_t sessions, int intra, int inter) {
+        for (bool spinning : {true, false}) {
+            ThreadProfile candidate;
+            candidate.session_pool_size = sessions;
+            candidate.intra_threads = intra;
+            candidate.inter_threads = inter;
+            candidate.allow_spinning = spinning;
+            candidates.push_back(candidate);
+        }
+    };
+
+    // Pool widths in powers of two; each either owns its share of the
+    // cores or half of it, leaving room for the rest of the pipeline
+    for (size_t sessions = 1; sessions <= cores; sessions *= 2) {
+        int share = static_cast<int>(cores / sessions);
+        add(sessions, share, 0);
+        if (share >= 4) {
+            add(sessions, share / 2, 0);
+        }
+    }
+
+    // Parallel execution only has a chance with one stream of work
+    if (cores >= 4) {
+        add(1, static_cast<int>(cores) - 2, 2);
+    }
+    return candidates;
+}
+
+int ThreadTuner::SelectBest(const std::vector<ThreadProfile>& measured, double target_p95_ms) {
+    int best = -1;
+
+    // Highest throughput within the latency bound
+    for (size_t i = 0; i < measured.size(); i++) {
+        if (target_p95_ms > 0 && measured[i].p95_ms > target_p95_ms) {
+            continue;
+        }
+        if (best < 0 || measured[i].throughput > measured[best].throughput) {
+            best = static_cast<int>(i);
+        }
+    }
+
+    // Nothing meets the bound: get as close to it as possible
+    if (best < 0) {
+        for (size_t i = 0; i < measured.size(); i++) {
+            if (best < 0 || measured[i].p95_ms < measured[best].p95_ms) {
+                best = static_cast<int>(i);
+            }
+        }
+    }
+    return best;
+}
+
+// ==========================================
+// Measurement
+// ==========================================
+
+ThreadProfile ThreadTuner::Tune() {
+    unsigned int cores = std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<ThreadProfile> measured;
+    for (ThreadProfile candidate : Candidates(cores)) {
+        if (!Measure(candidate)) {
+            continue;
+        }
+
+        if (options.verbose) {
+            std::cout << "Thread layout " << candidate.session_pool_size << "x"
+                      << candidate.intra_threads << " inter " << candidate.inter_threads
+                      << (candidate.allow_spinning ? " spin" : " no-spin") << ": "
+                      << candidate.throughput << " inf/s, p95 " << candidate.p95_ms
+                      << " ms" << std::endl;
+        }
+        measured.push_back(candidate);
+    }
+
+    int best = SelectBest(measured, options.target_p95_ms);
+    if (best < 0) {
+        ThreadProfile none;
+        none.session_pool_size = 0;
+        return none;
+    }
+
+    ThreadProfile profile = measured[best];
+    profile.host = HostName();
+    profile.cores = cores;
+    profile.model_path = options.model_path;
+    profile.model_size = FileUtils::GetFileSize(options.model_path);
+    return profile;
+}
+
+bool ThreadTuner::Measure(ThreadProfile& candidate) const {
+    SessionManager session;
+    session.SetPoolSize(candidate.session_pool_size);
+    session.SetNumThreads(candidate.intra_threads);
+    session.SetInterOpThreads(candidate.inter_threads);
+    session.SetAllowSpinning(candidate.allow_spinning);
+    session.SetOptimizedModelCache(options.cache_optimized_model, options.optimized_model_dir);
+    session.SetMemoryMapping(options.mmap_model);
+    session.SetVocoderModel(options.vocoder_model_path);
+    if (!session.LoadModel(options.model_path)) {
+        return false;
+    }
+    if (!session.Warmup(options.token_lengths)) {
+        return false;
+    }
+    std::vector<float> style = options.style_vector.empty() ?
+        std::vector<float>(session.GetStyleDim(), 0.5f) : options.style_vector;
+
+    std::vector<std::vector<int>> inputs;
+    for (size_t length : options.token_lengths) {
+        std::vector<int> tokens(std::max<size_t>(1, length));
+        for (size_t i = 0; i < tokens.size(); i++) {
+            tokens[i] = options.token_pattern[i % options.token_pattern.size()];
+        }
+        inputs.push_back(std::move(tokens));
+    }
+
+    // One closed-loop client per session keeps the pool saturated
+    LatencyHistogram latencies;
+    std::atomic<size_t> completed{0};
+    std::atomic<bool> failed{false};
+    auto start = std::chrono::steady_clock::now();
+    auto deadline = start + options.run_time;
+
+    std::vector<std::thread> clients;
+    for (size_t c = 0; c < candidate.session_pool_size; c++) {
+        clients.emplace_back([&, c]() {
+            for (size_t i = c; std::chrono::steady_clock::now() < deadline; i++) {
+                auto run_start = std::chrono::steady_clock::now();
+                if (session.RunInference(inputs[i % inputs.size()], style).empty()) {
+                    failed = true;
+                    return;
+                }
+                latencies.Record(std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - run_start));
+                completed++;
+            }
+        });
+    }
+    for (auto& client : clients) {
+        client.join();
+    }
+
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (failed || completed == 0 || elapsed <= 0) {
+        return false;
+    }
+
+    candidate.throughput = completed / elapsed;
+    candidate.p95_ms = latencies.GetSnapshot().Percentile(95) / 1000.0;
+    return true;
+}
+
+// ==========================================
+// Profile Persistence
+// ==========================================
+
+std::string ThreadTuner::HostName() {
+#ifdef _WIN32
+    char name[MAX_COMPUTERNAME_LENGTH + 1];
+    DWORD size = sizeof(name);
+    if (GetComputerNameA(name, &size)) {
+        return std::string(name, size);
+    }
+#else
+    char name[256];
+    if (gethostname(name, sizeof(name)) == 0) {
+        name[sizeof(name) - 1] = '\0';
+        return name;
+    }
+#endif
+    return "localhost";
+}
+
+std::string ThreadTuner::DefaultProfilePath(const std::string& model_path) {
+    return FileUtils::JoinPath(FileUtils::GetDirectory(model_path),
+                               "thread_profile." + HostName() + ".json");
+}
+
+bool ThreadTuner::Matches(const ThreadProfile& profile, const std::string& model_path) {
+    // A changed core count (e.g. a resized container) invalidates the sweep
+    return profile.session_pool_size > 0 &&
+           profile.host == HostName() &&
+           profile.cores == std::max(1u, std::thread::hardware_concurrency()) &&
+           profile.model_path == model_path &&
+           profile.model_size == FileUtils::GetFileSize(model_path);
+}
+
+bool ThreadTuner::LoadProfile(const std::string& path, ThreadProfile& profile) {
+    std::string content = FileUtils::ReadTextFile(path);
+    if (content.empty()) {
+        return false;
+    }
+
+    try {
+        json j = json::parse(content);
+        ThreadProfile loaded;
+        loaded.session_pool_size = j.at("session_pool_size").get<size_t>();
+        loaded.intra_threads = j.at("intra_threads").get<int>();
+        loaded.inter_threads = j.at("inter_threads").get<int>();
+        loaded.allow_spinning = j.at("allow_spinning").get<bool>();
+        loaded.throughput = j.value("throughput", 0.0);
+        loaded.p95_ms = j.value("p95_ms", 0.0);
+        loaded.host = j.at("host").get<std::string>();
+        loaded.cores = j.at("cores").get<unsigned int>();
+        loaded.model_path = j.at("model_path").get<std::string>();
+        loaded.model_size = j.at("model_size").get<int64_t>();
+        profile = loaded;
+        return true;
+
+    } catch (const json::exception& e) {
+        std::cerr << "Ignoring invalid thread profile " << path << ": " << e.what() << std::endl;
+        return false;
+    }
+}
+
+bool ThreadTuner::SaveProfile(const std::string& path, const ThreadProfile& profile) {
+    json j;
+    j["session_pool_size"] = profile.session_pool_size;
+    j["intra_threads"] = profile.intra_threads;
+    j["inter_threads"] = profile.inter_threads;
+    j["allow_spinning"] = profile.allow_spinning;
+    j["throughput"] = profile.throughput;
+    j["p95_ms"] = profile.p95_ms;
+    j["host"] = profile.host;
+    j["cores"] = profile.cores;
+    j["model_path"] = profile.model_path;
+    j["model_size"] = profile.model_size;
+    return FileUtils::WriteTextFile(path, j.dump(2));
+}
+
+} // namespace jp_edge_tts
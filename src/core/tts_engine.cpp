@@ -8,13 +8,23 @@
  */
 
 #include "jp_edge_tts/core/tts_engine.h"
+#include "jp_edge_tts/config.h"
 #include "jp_edge_tts/core/session_manager.h"
 #include "jp_edge_tts/core/voice_manager.h"
 #include "jp_edge_tts/core/cache_manager.h"
+#include "jp_edge_tts/core/request_scheduler.h"
+#include "jp_edge_tts/core/inference_batcher.h"
+#include "jp_edge_tts/core/thread_tuner.h"
 #include "jp_edge_tts/phonemizer/japanese_phonemizer.h"
 #include "jp_edge_tts/tokenizer/ipa_tokenizer.h"
 #include "jp_edge_tts/audio/audio_processor.h"
 #include "jp_edge_tts/utils/thread_pool.h"
+#include "jp_edge_tts/utils/bounded_queue.h"
+#include "jp_edge_tts/utils/cancellation_token.h"
+#include "jp_edge_tts/utils/file_utils.h"
+#include "jp_edge_tts/utils/single_flight.h"
+#include "jp_edge_tts/utils/latency_histogram.h"
+#include "jp_edge_tts/utils/trace.h"
 #include "jp_edge_tts/utils/string_utils.h"
 
 #include <iostream>
@@ -24,6 +34,8 @@
 #include <random>
 #include <sstream>
 #include <iomanip>
+#include <filesystem>
+#include <unordered_map>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -39,314 +51,1886 @@ namespace jp_edge_tts {
 
 class TTSEngine::Impl {
 public:
-    TTSConfig config;
-    std::unique_ptr<SessionManager> session_manager;
-    std::unique_ptr<VoiceManager> voice_manager;
+    /**
+     * @brief One loaded model variant and its own inference cost estimate
+     */
+    struct ModelTier {
+        std::string name;
+        std::string model_path;
+        std::string vocoder_path;
+        std::string files;                             // FileIdentity of both, as loaded
+        std::shared_ptr<SessionManager> session_manager;
+        std::shared_ptr<InferenceBatcher> batcher;     // Uses session_manager; null if off
+
+        // Moving average of inference cost, used to shed requests that
+        // cannot meet their deadline (0 until the first inference)
+        std::shared_ptr<std::atomic<double>> us_per_token;
+    };
+
+    /**
+     * @brief Model components that serve requests together
+     *
+     * @details A request pins the snapshot it starts on, so a reload
+     * never swaps components underneath it. Components a reload leaves
+     * unchanged are shared with the previous snapshot. Snapshots are
+     * read with std::atomic_load and replaced with std::atomic_store.
+     */
+    struct EngineSnapshot {
+        uint64_t version = 0;                          // Part of every cache key
+        TTSConfig config;
+        std::vector<ModelTier> tiers;                  // Primary first, then faster variants
+        std::shared_ptr<SessionManager> session_manager;  // Primary tier's
+        std::shared_ptr<InferenceBatcher> batcher;     // Primary tier's
+        std::shared_ptr<JapanesePhonemizer> phonemizer;
+        std::shared_ptr<IPATokenizer> tokenizer;
+        std::shared_ptr<VoiceManager> voice_manager;
+        size_t dictionary_bytes = 0;                   // Measured once per phonemizer
+        std::string phonemizer_files;                  // FileIdentity of its inputs, as loaded
+        std::string vocabulary_file;                   // FileIdentity of the vocabulary, as loaded
+    };
+    using SnapshotPtr = std::shared_ptr<EngineSnapshot>;
+
+    TTSConfig config;                        // As of Initialize(); reloads publish theirs in the snapshot
     std::unique_ptr<CacheManager> cache_manager;
-    std::unique_ptr<JapanesePhonemizer> phonemizer;
-    std::unique_ptr<IPATokenizer> tokenizer;
     std::unique_ptr<AudioProcessor> audio_processor;
     std::unique_ptr<ThreadPool> thread_pool;
 
+    // Current components
+    SnapshotPtr snapshot;
+    std::atomic<uint64_t> next_snapshot_version{1};
+    std::mutex reload_mutex;                 // Serializes snapshot builds
+
+    // Voices loaded through LoadVoice, replayed into every new snapshot
+    std::vector<std::string> extra_voice_paths;
+
     // State tracking
     std::atomic<bool> initialized{false};
+    std::atomic<bool> shutting_down{false};
     std::atomic<size_t> active_synthesis_count{0};
     std::atomic<size_t> total_requests{0};
     std::atomic<size_t> successful_requests{0};
     std::atomic<size_t> failed_requests{0};
 
-    // Request queue
-    struct QueuedRequest {
-        std::string id;
+    // Request scheduling
+    std::unique_ptr<RequestScheduler> scheduler;
+    std::atomic<uint64_t> next_request_id{1};
+
+    /**
+     * @brief Per-request state carried between synthesis stages
+     */
+    struct SynthesisJob {
         TTSRequest request;
-        std::promise<TTSResult> promise;
-        AudioCallback callback;
-        std::chrono::steady_clock::time_point submitted;
+        SnapshotPtr snapshot;
+        TTSResult result;
+        std::string cache_key;
+        std::vector<int> tokens;
+        std::optional<Voice> voice;
+        std::vector<float> raw_audio;
+        size_t tier = 0;                     // Index into snapshot->tiers
+        bool tier_chosen = false;            // Set once ChooseTier has run
+        std::chrono::high_resolution_clock::time_point start_time;
+        std::promise<TTSResult> completion;  // Used only when pipelined
     };
 
-    std::queue<QueuedRequest> request_queue;
-    std::mutex queue_mutex;
-    std::condition_variable queue_cv;
-    std::thread queue_processor;
-    std::atomic<bool> stop_processing{false};
+    using JobPtr = std::shared_ptr<SynthesisJob>;
+
+    /**
+     * @brief One pipeline stage: a bounded input queue and its workers
+     */
+    struct PipelineStage {
+        std::string name;
+        std::function<bool(SynthesisJob&)> run;
+        std::unique_ptr<BoundedQueue<JobPtr>> queue;
+        std::vector<std::thread> workers;
+        std::atomic<size_t> processed{0};
+        std::atomic<int64_t> busy_us{0};
+    };
+
+    // Identical cacheable requests in flight, keyed by cache key
+    SingleFlight<std::string, TTSResult> in_flight;
+
+    // Stage pipeline (empty unless config.enable_pipeline)
+    std::vector<std::unique_ptr<PipelineStage>> pipeline_stages;
+
+    // Tokens of scheduled requests, for CancelRequest on running work
+    std::unordered_map<std::string, std::shared_ptr<CancellationToken>> request_tokens;
+    std::mutex request_tokens_mutex;
+
+    // Memory budget (0 = unlimited) and bytes held by queued requests
+    std::atomic<size_t> max_memory_bytes{0};
+    std::atomic<size_t> queued_request_bytes{0};
+    std::atomic<std::chrono::steady_clock::rep> last_arena_shrink{0};
+
+    // Timings from the last Warmup() and model load
+    std::vector<TTSEngine::WarmupStats> warmup_report;
+    TTSEngine::StartupStats startup_report;
+    mutable std::mutex warmup_mutex;
+
+    // Callbacks
+    ProgressCallback progress_callback;
+    ErrorCallback error_callback;
+
+    // Performance tracking (microsecond histograms, merged on read)
+    struct LatencyHistograms {
+        LatencyHistogram total;
+        LatencyHistogram phonemization;
+        LatencyHistogram tokenization;
+        LatencyHistogram inference;
+        LatencyHistogram audio_processing;
+    } latency;
+    std::atomic<std::chrono::steady_clock::rep> stats_start{
+        std::chrono::steady_clock::now().time_since_epoch().count()};
+
+    // Last error message (guarded by reload_mutex)
+    std::string last_error;
+
+    /**
+     * @brief Constructor
+     */
+    Impl(const TTSConfig& cfg) : config(cfg) {
+        // Initialize components; voices can be loaded before Initialize()
+        auto initial = std::make_shared<EngineSnapshot>();
+        initial->config = config;
+        initial->voice_manager = std::make_shared<VoiceManager>();
+        snapshot = std::move(initial);
+        cache_manager = std::make_unique<CacheManager>(config.max_cache_size_mb * 1024 * 1024);
+        max_memory_bytes = config.max_memory_mb * 1024 * 1024;
+
+        // Create thread pool for parallel processing
+        int num_threads = config.max_concurrent_requests > 0 ?
+                         config.max_concurrent_requests : std::thread::hardware_concurrency();
+        thread_pool = std::make_unique<ThreadPool>(num_threads);
+    }
+
+    /**
+     * @brief Destructor
+     */
+    ~Impl() {
+        // Batch work not yet started is answered as cancelled
+        shutting_down = true;
+
+        // Stop request scheduling; queued requests are cancelled
+        if (scheduler) {
+            scheduler->Shutdown();
+        }
+
+        // Pool tasks use the members below, so they must finish first;
+        // pipeline stages may still be waiting on them
+        if (thread_pool) {
+            thread_pool->wait_all();
+        }
+        StopPipeline();
+        thread_pool.reset();
+    }
+
+    /**
+     * @brief Initialize all components
+     */
+    Status Initialize() {
+        std::lock_guard<std::mutex> lock(reload_mutex);
+
+        try {
+            // A tuned per-host thread layout replaces the automatic one
+            TTSConfig effective = config;
+            bool profiled = ApplyThreadProfile(effective);
+
+            SnapshotPtr built;
+            auto status = BuildSnapshot(effective, nullptr, built);
+            if (status != Status::OK) {
+                return status;
+            }
+
+            if (!profiled && effective.auto_tune_threads && UsesAutoThreads(effective)) {
+                status = TuneThreads(effective, built);
+                if (status != Status::OK) {
+                    return status;
+                }
+            }
+            config = effective;
+
+            // Initialize audio processor
+            audio_processor = std::make_unique<AudioProcessor>(config.target_sample_rate);
+
+            PublishSnapshot(std::move(built));
+
+            // Start stage workers before any request can reach them
+            if (config.enable_pipeline) {
+                StartPipeline();
+            }
+
+            // Start request scheduler workers
+            int num_workers = config.max_concurrent_requests > 0 ?
+                             config.max_concurrent_requests : std::thread::hardware_concurrency();
+            scheduler = std::make_unique<RequestScheduler>(num_workers, config.max_queue_size);
+
+            initialized = true;
+            return Status::OK;
+
+        } catch (const std::exception& e) {
+            last_error = std::string("Initialization error: ") + e.what();
+            return Status::ERROR_INVALID_INPUT;
+        }
+    }
+
+    // ==========================================
+    // Component Snapshots
+    // ==========================================
+
+    SnapshotPtr CurrentSnapshot() const {
+        return std::atomic_load(&snapshot);
+    }
+
+    void PublishSnapshot(SnapshotPtr next) {
+        std::atomic_store(&snapshot, std::move(next));
+    }
+
+    // ==========================================
+    // Thread Layout Profiles
+    // ==========================================
+
+    static bool UsesAutoThreads(const TTSConfig& cfg) {
+        return cfg.onnx_session_pool_size == 0 && cfg.onnx_intra_threads == 0 &&
+               cfg.onnx_inter_threads == 0;
+    }
+
+    static std::string ThreadProfilePath(const TTSConfig& cfg) {
+        return cfg.thread_profile_path.empty() ?
+               ThreadTuner::DefaultProfilePath(cfg.kokoro_model_path) : cfg.thread_profile_path;
+    }
+
+    static void ApplyProfile(const ThreadProfile& profile, TTSConfig& cfg) {
+        cfg.onnx_session_pool_size = profile.session_pool_size;
+        cfg.onnx_intra_threads = profile.intra_threads;
+        cfg.onnx_inter_threads = profile.inter_threads;
+        cfg.onnx_allow_spinning = profile.allow_spinning;
+    }
+
+    /**
+     * @brief Fill automatic thread settings from this host's profile
+     *
+     * @details Only applies when every thread setting is on auto, so
+     * explicit configuration always wins.
+     *
+     * @return true if a profile measured here for this model was applied
+     */
+    static bool ApplyThreadProfile(TTSConfig& cfg) {
+        if (!UsesAutoThreads(cfg)) {
+            return false;
+        }
+
+        ThreadProfile profile;
+        if (!ThreadTuner::LoadProfile(ThreadProfilePath(cfg), profile) ||
+            !ThreadTuner::Matches(profile, cfg.kokoro_model_path)) {
+            return false;
+        }
+        ApplyProfile(profile, cfg);
+        return true;
+    }
+
+    /**
+     * @brief Benchmark thread layouts, save the winner and rebuild with it
+     *
+     * @param cfg Configuration; receives the tuned layout
+     * @param built Snapshot built for cfg; replaced by one using the layout
+     *
+     * @note Caller must hold reload_mutex
+     */
+    Status TuneThreads(TTSConfig& cfg, SnapshotPtr& built) {
+        ThreadTuner::Options options;
+        options.model_path = cfg.kokoro_model_path;
+        options.token_pattern = built->tokenizer->PhonemesToTokens("koɴɲitɕiwa sekai");
+        options.token_lengths = WarmupLengths(cfg);
+        options.target_p95_ms = cfg.auto_tune_target_p95_ms;
+        options.cache_optimized_model = cfg.cache_optimized_model;
+        options.optimized_model_dir = cfg.optimized_model_dir;
+        options.mmap_model = cfg.mmap_model;
+        options.vocoder_model_path = cfg.kokoro_vocoder_model_path;
+        options.verbose = cfg.verbose;
+
+        auto voices = built->voice_manager->GetAllVoices();
+        options.style_vector = voices.empty() ?
+            std::vector<float>(built->session_manager->GetStyleDim(), 0.5f) :
+            voices.front().style_vector;
+
+        // Candidates should not compete with the default pool for memory
+        built->tiers.clear();
+        built->batcher.reset();
+        built->session_manager.reset();
+
+        ThreadProfile profile = ThreadTuner(options).Tune();
+        if (profile.session_pool_size == 0) {
+            last_error = "Thread auto-tuning could not run the model";
+            return Status::ERROR_MODEL_NOT_LOADED;
+        }
+
+        std::string path = ThreadProfilePath(cfg);
+        if (!ThreadTuner::SaveProfile(path, profile) && cfg.verbose) {
+            std::cout << "Could not save thread profile to " << path << std::endl;
+        }
+
+        ApplyProfile(profile, cfg);
+        SnapshotPtr tuned;
+        auto status = BuildSnapshot(cfg, built, tuned);
+        if (status == Status::OK) {
+            built = std::move(tuned);
+        }
+        return status;
+    }
+
+    /**
+     * @brief Representative token lengths, capped at the chunk size
+     */
+    static std::vector<size_t> WarmupLengths(const TTSConfig& cfg) {
+        static const size_t kWarmupLengths[] = {16, 50, 150, 400};
+
+        // Longer inputs are chunked, so the session never sees them
+        std::vector<size_t> lengths;
+        for (size_t length : kWarmupLengths) {
+            length = std::min(length, cfg.max_chunk_tokens);
+            if (lengths.empty() || lengths.back() != length) {
+                lengths.push_back(length);
+            }
+        }
+        return lengths;
+    }
+
+    /**
+     * @brief Keep the model load timing for GetStartupReport()
+     */
+    void RecordModelLoad(const TTSConfig& cfg, const SessionManager::LoadStats& stats) {
+        TTSEngine::StartupStats report;
+        report.model_load_time = stats.load_time;
+        report.optimized_model_cached = stats.used_optimized_model;
+        report.time_saved = stats.time_saved;
+        report.optimized_model_path = stats.optimized_model_path;
+
+        if (cfg.verbose) {
+            std::cout << "Model loaded in " << report.model_load_time.count() << " ms";
+            if (stats.used_optimized_model) {
+                std::cout << " from optimized cache (saved ~" << report.time_saved.count() << " ms)";
+            } else if (stats.wrote_optimized_model) {
+                std::cout << "; optimized graph cached at " << stats.optimized_model_path;
+            }
+            std::cout << std::endl;
+        }
+
+        std::lock_guard<std::mutex> lock(warmup_mutex);
+        startup_report = std::move(report);
+    }
+
+    /**
+     * @brief Size and modification time of a file
+     *
+     * @details Deployments usually replace model and dictionary files in
+     * place, so an unchanged path does not mean unchanged contents.
+     */
+    static std::string FileIdentity(const std::string& path) {
+        if (path.empty()) {
+            return "";
+        }
+        return std::to_string(FileUtils::GetFileSize(path)) + "@" +
+               std::to_string(FileUtils::GetModificationTime(path));
+    }
+
+    /**
+     * @brief Load one model tier
+     *
+     * @param cfg Configuration to build for
+     * @param model_path Model to load
+     * @param vocoder_path Split model vocoder (empty = single graph)
+     * @param reusable Snapshot whose tiers may be reused (may be null)
+     * @param tier Receives the sessions; name is set by the caller
+     *
+     * @note Caller must hold reload_mutex
+     */
+    Status BuildTier(const TTSConfig& cfg, const std::string& model_path,
+                     const std::string& vocoder_path, const EngineSnapshot* reusable,
+                     ModelTier& tier) {
+        tier.model_path = model_path;
+        tier.vocoder_path = vocoder_path;
+        tier.files = FileIdentity(model_path) + "|" + FileIdentity(vocoder_path);
+
+        // Models replaced in place under the same path must be reloaded
+        const ModelTier* existing = nullptr;
+        if (reusable) {
+            for (const auto& candidate : reusable->tiers) {
+                if (candidate.model_path == model_path && candidate.vocoder_path == vocoder_path &&
+                    candidate.files == tier.files) {
+                    existing = &candidate;
+                    break;
+                }
+            }
+        }
+
+        if (existing) {
+            tier.session_manager = existing->session_manager;
+            tier.us_per_token = existing->us_per_token;
+        } else {
+            // One pooled session per concurrent worker by default
+            size_t max_concurrent = cfg.max_concurrent_requests > 0 ?
+                static_cast<size_t>(cfg.max_concurrent_requests) : std::thread::hardware_concurrency();
+            tier.session_manager = std::make_shared<SessionManager>();
+            tier.session_manager->SetUseGPU(cfg.enable_gpu);
+            tier.session_manager->SetPoolSize(cfg.onnx_session_pool_size, max_concurrent);
+            tier.session_manager->SetNumThreads(cfg.onnx_intra_threads);
+            tier.session_manager->SetInterOpThreads(cfg.onnx_inter_threads);
+            tier.session_manager->SetAllowSpinning(cfg.onnx_allow_spinning);
+            tier.session_manager->SetOptimizedModelCache(cfg.cache_optimized_model,
+                                                         cfg.optimized_model_dir);
+            tier.session_manager->SetMemoryMapping(cfg.mmap_model);
+            tier.session_manager->SetVocoderModel(vocoder_path);
+            tier.session_manager->SetVocoderWindow(cfg.vocoder_window_frames,
+                                                   cfg.vocoder_context_frames);
+            if (!tier.session_manager->LoadModel(model_path)) {
+                last_error = "Failed to load Kokoro model from: " + model_path;
+                return Status::ERROR_MODEL_NOT_LOADED;
+            }
+            tier.us_per_token = std::make_shared<std::atomic<double>>(0.0);
+        }
+
+        // Coalesce concurrent inference calls when batching is enabled
+        bool same_batching = existing && existing->batcher &&
+                             reusable->config.max_batch_size == cfg.max_batch_size &&
+                             reusable->config.max_batch_wait_ms == cfg.max_batch_wait_ms &&
+                             reusable->config.batch_bucket_tokens == cfg.batch_bucket_tokens;
+        if (same_batching) {
+            tier.batcher = existing->batcher;
+        } else if (cfg.max_batch_size > 1) {
+            tier.batcher = std::make_shared<InferenceBatcher>(
+                *tier.session_manager, cfg.max_batch_size,
+                cfg.max_batch_wait_ms, cfg.batch_bucket_tokens);
+        }
+        return Status::OK;
+    }
+
+    /**
+     * @brief Build components for a configuration
+     *
+     * @param cfg Configuration to build for
+     * @param previous Snapshot whose unchanged components are reused (may be null)
+     * @param out Receives the new snapshot on success
+     *
+     * @note Caller must hold reload_mutex
+     */
+    Status BuildSnapshot(const TTSConfig& cfg, const SnapshotPtr& previous, SnapshotPtr& out) {
+        auto next = std::make_shared<EngineSnapshot>();
+        next->config = cfg;
+
+        // Sessions of unchanged models are reused unless a setting that
+        // shapes them changed
+        bool same_sessions = previous &&
+                             previous->config.vocoder_window_frames == cfg.vocoder_window_frames &&
+                             previous->config.vocoder_context_frames == cfg.vocoder_context_frames &&
+                             previous->config.enable_gpu == cfg.enable_gpu &&
+                             previous->config.onnx_session_pool_size == cfg.onnx_session_pool_size &&
+                             previous->config.onnx_intra_threads == cfg.onnx_intra_threads &&
+                             previous->config.onnx_inter_threads == cfg.onnx_inter_threads &&
+                             previous->config.onnx_allow_spinning == cfg.onnx_allow_spinning &&
+                             previous->config.max_concurrent_requests == cfg.max_concurrent_requests &&
+                             previous->config.cache_optimized_model == cfg.cache_optimized_model &&
+                             previous->config.optimized_model_dir == cfg.optimized_model_dir &&
+                             previous->config.mmap_model == cfg.mmap_model;
+        const EngineSnapshot* reusable = same_sessions ? previous.get() : nullptr;
+
+        // Initialize ONNX sessions for the Kokoro model tiers
+        ModelTier primary;
+        primary.name = cfg.model_tier_name;
+        Status tier_status = BuildTier(cfg, cfg.kokoro_model_path, cfg.kokoro_vocoder_model_path,
+                                       reusable, primary);
+        if (tier_status != Status::OK) {
+            return tier_status;
+        }
+        if (!previous || primary.session_manager != previous->session_manager) {
+            RecordModelLoad(cfg, primary.session_manager->GetLoadStats());
+        }
+        next->session_manager = primary.session_manager;
+        next->batcher = primary.batcher;
+        next->tiers.push_back(std::move(primary));
+
+        for (const auto& fallback : cfg.fallback_tiers) {
+            ModelTier tier;
+            tier.name = fallback.name;
+            tier_status = BuildTier(cfg, fallback.model_path, "", reusable, tier);
+            if (tier_status != Status::OK) {
+                return tier_status;
+            }
+            next->tiers.push_back(std::move(tier));
+        }
+
+        // Initialize phonemizer
+        next->phonemizer_files = FileIdentity(cfg.dictionary_path) + "|" +
+                                 FileIdentity(cfg.phonemizer_model_path);
+        bool same_phonemizer = previous && previous->phonemizer &&
+                               previous->phonemizer_files == next->phonemizer_files &&
+                               previous->config.dictionary_path == cfg.dictionary_path &&
+                               previous->config.phonemizer_model_path == cfg.phonemizer_model_path &&
+                               previous->config.enable_mecab == cfg.enable_mecab &&
+                               previous->config.enable_cache == cfg.enable_cache;
+        if (same_phonemizer) {
+            next->phonemizer = previous->phonemizer;
+            next->dictionary_bytes = previous->dictionary_bytes;
+        } else {
+            JapanesePhonemizer::Config phonemizer_config;
+            phonemizer_config.dictionary_path = cfg.dictionary_path;
+            phonemizer_config.onnx_model_path = cfg.phonemizer_model_path;
+            phonemizer_config.use_mecab = cfg.enable_mecab;
+            phonemizer_config.enable_cache = cfg.enable_cache;
+
+            next->phonemizer = std::make_shared<JapanesePhonemizer>(phonemizer_config);
+            auto status = next->phonemizer->Initialize();
+            if (status != Status::OK) {
+                last_error = "Failed to initialize phonemizer";
+                return status;
+            }
+            next->dictionary_bytes = next->phonemizer->GetMemoryUsage();
+        }
+
+        // Initialize tokenizer
+        next->vocabulary_file = FileIdentity(cfg.tokenizer_vocab_path);
+        bool same_vocabulary = previous && previous->tokenizer &&
+                               previous->vocabulary_file == next->vocabulary_file &&
+                               previous->config.tokenizer_vocab_path == cfg.tokenizer_vocab_path;
+        if (same_vocabulary) {
+            next->tokenizer = previous->tokenizer;
+        } else {
+            next->tokenizer = std::make_shared<IPATokenizer>();
+            if (!next->tokenizer->LoadVocabulary(cfg.tokenizer_vocab_path)) {
+                last_error = "Failed to load tokenizer vocabulary from: " + cfg.tokenizer_vocab_path;
+                return Status::ERROR_FILE_NOT_FOUND;
+            }
+        }
+
+        // Voices are always re-read so edited voice files are picked up
+        next->voice_manager = std::make_shared<VoiceManager>();
+        LoadVoicesFromDirectory(*next->voice_manager, cfg.voices_dir);
+        for (const auto& path : extra_voice_paths) {
+            next->voice_manager->LoadVoice(path);
+        }
+        if (previous && previous->voice_manager) {
+            next->voice_manager->SetDefaultVoice(previous->voice_manager->GetDefaultVoiceId());
+        }
+
+        next->version = next_snapshot_version.fetch_add(1);
+        out = std::move(next);
+        return Status::OK;
+    }
+
+    /**
+     * @brief Build, warm and publish components for a new configuration
+     *
+     * @details Requests keep running on the current snapshot until the
+     * new one is published; on failure the current one stays in place.
+     */
+    Status Reload(const TTSConfig& requested) {
+        std::lock_guard<std::mutex> lock(reload_mutex);
+
+        try {
+            SnapshotPtr current = CurrentSnapshot();
+
+            // The audio processor is shared by all snapshots
+            TTSConfig new_config = requested;
+            new_config.target_sample_rate = current->config.target_sample_rate;
+            ApplyThreadProfile(new_config);
+
+            SnapshotPtr next;
+            auto status = BuildSnapshot(new_config, current, next);
+            if (status != Status::OK) {
+                return status;
+            }
+
+            // Only new models need warming; shared components already are
+            if (HasNewModel(*next, *current)) {
+                status = RunWarmup(next);
+                if (status != Status::OK) {
+                    last_error = "Warmup failed for reloaded model";
+                    return status;
+                }
+            }
+
+            PublishSnapshot(std::move(next));
+            return Status::OK;
+
+        } catch (const std::exception& e) {
+            last_error = std::string("Reload error: ") + e.what();
+            return Status::ERROR_INVALID_INPUT;
+        }
+    }
+
+    static bool HasNewModel(const EngineSnapshot& next, const EngineSnapshot& current) {
+        for (const auto& tier : next.tiers) {
+            bool reused = std::any_of(current.tiers.begin(), current.tiers.end(),
+                [&](const ModelTier& old) { return old.session_manager == tier.session_manager; });
+            if (!reused) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Load voices from directory
+     */
+    void LoadVoicesFromDirectory(VoiceManager& voices, const std::string& dir) {
+        namespace fs = std::filesystem;
+
+        if (!fs::exists(dir)) {
+            return;
+        }
+
+        for (const auto& entry : fs::directory_iterator(dir)) {
+            if (entry.path().extension() == ".json") {
+                voices.LoadVoice(entry.path().string());
+            }
+        }
+    }
+
+    /**
+     * @brief Process synthesis request and record request statistics
+     */
+    TTSResult ProcessSynthesis(const TTSRequest& request) {
+        return ProcessSynthesis(request, CurrentSnapshot());
+    }
+
+    TTSResult ProcessSynthesis(const TTSRequest& request, const SnapshotPtr& snap) {
+        auto start_time = std::chrono::high_resolution_clock::now();
+        TTSResult result = DeadlinePassed(request) ?
+            MakeErrorResult(Status::ERROR_TIMEOUT, "Deadline passed before synthesis started") :
+            SynthesizeText(request, snap);
+        RecordOutcome(result, ElapsedMicros(start_time));
+        return result;
+    }
+
+    /**
+     * @brief Check whether a request's deadline has already passed
+     */
+    static bool DeadlinePassed(const TTSRequest& request) {
+        return request.deadline.has_value() &&
+               std::chrono::steady_clock::now() >= *request.deadline;
+    }
+
+    /**
+     * @brief Build a failed result
+     */
+    static TTSResult MakeErrorResult(Status status, const std::string& message) {
+        TTSResult result;
+        result.status = status;
+        result.error_message = message;
+        return result;
+    }
+
+    /**
+     * @brief Run the synthesis pipeline for one piece of text
+     *
+     * @details Does not touch the request counters so that streaming can
+     * run it once per segment and account for the whole request once.
+     * Cacheable requests are coalesced on their cache key and quality
+     * hint: callers that arrive while an identical request is being
+     * synthesized share its result instead of running inference again.
+     */
+    TTSResult SynthesizeText(const TTSRequest& request, const SnapshotPtr& snap) {
+        std::string cache_key = GenerateCacheKey(request, snap->version);
+        if (!request.use_cache) {
+            return RunStages(request, cache_key, snap);
+        }
+
+        // Attached callers stop waiting on their own deadline and token
+        bool attached = false;
+        auto deadline = request.deadline.value_or(std::chrono::steady_clock::time_point::max());
+        std::optional<TTSResult> shared = in_flight.DoUntil(CoalescingKey(request, cache_key), [&]() {
+            return RunStages(request, cache_key, snap);
+        }, deadline, [&request]() { return IsCancelled(request); }, &attached);
+
+        if (!shared) {
+            return IsCancelled(request) ?
+                MakeErrorResult(Status::ERROR_CANCELLED, "Request cancelled while waiting for an identical request") :
+                MakeErrorResult(Status::ERROR_TIMEOUT, "Deadline passed while waiting for an identical request");
+        }
+        TTSResult result = std::move(*shared);
+
+        if (attached) {
+            // The leader may have been shed for its own, tighter deadline,
+            // or cancelled by its own caller; retry only if this request
+            // can still use the result
+            if (result.status == Status::ERROR_TIMEOUT ||
+                (result.status == Status::ERROR_CANCELLED && !IsCancelled(request))) {
+                if (IsCancelled(request)) {
+                    return MakeErrorResult(Status::ERROR_CANCELLED, "Request cancelled");
+                }
+                if (DeadlinePassed(request)) {
+                    return MakeErrorResult(Status::ERROR_TIMEOUT,
+                                           "Deadline passed while waiting for an identical request");
+                }
+                return RunStages(request, cache_key, snap);
+            }
+            // Served without running inference, same as a cache hit
+            result.stats.cache_hit = true;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Run all synthesis stages for one request
+     *
+     * @details With pipelining enabled the stages run on their own
+     * workers; otherwise they run back-to-back on the calling thread.
+     */
+    TTSResult RunStages(const TTSRequest& request, const std::string& cache_key,
+                        const SnapshotPtr& snap) {
+        auto job = std::make_shared<SynthesisJob>();
+        job->request = request;
+        job->cache_key = cache_key;
+        job->snapshot = snap;
+        job->start_time = std::chrono::high_resolution_clock::now();
+
+        if (!pipeline_stages.empty()) {
+            auto future = job->completion.get_future();
+            if (!pipeline_stages.front()->queue->Push(job)) {
+                job->result.status = Status::ERROR_CANCELLED;
+                job->result.error_message = "Engine is shutting down";
+                return job->result;
+            }
+            return future.get();
+        }
+
+        try {
+            if (RunFrontEnd(*job) && RunInferenceStage(*job)) {
+                RunPostProcess(*job);
+            }
+        } catch (const std::exception& e) {
+            FailJob(*job, e);
+        }
+        return std::move(job->result);
+    }
+
+    static bool IsCancelled(const TTSRequest& request) {
+        return request.cancellation && request.cancellation->IsCancelled();
+    }
+
+    /**
+     * @brief Complete the job as cancelled if its token was cancelled
+     * @return true if the job was cancelled
+     */
+    static bool StopIfCancelled(SynthesisJob& job) {
+        if (!IsCancelled(job.request)) {
+            return false;
+        }
+        job.result.status = Status::ERROR_CANCELLED;
+        job.result.error_message = "Request cancelled";
+        return true;
+    }
+
+    /**
+     * @brief Record a stage exception; aborted inference reports as cancelled
+     */
+    static void FailJob(SynthesisJob& job, const std::exception& e) {
+        if (!StopIfCancelled(job)) {
+            job.result.status = Status::ERROR_INFERENCE_FAILED;
+            job.result.error_message = e.what();
+        }
+    }
+
+    // ==========================================
+    // Synthesis Stages
+    // ==========================================
+
+    /**
+     * @brief Stage 1: cache lookup, normalization, phonemization, tokenization
+     * @return false if the job is already complete (cache hit or error)
+     */
+    bool RunFrontEnd(SynthesisJob& job) {
+        const EngineSnapshot& snap = *job.snapshot;
+        const TTSRequest& request = job.request;
+        TTSResult& result = job.result;
+
+        result.stats.text_length = request.text.length();
+
+        if (StopIfCancelled(job)) {
+            return false;
+        }
+
+        // Check cache first
+        if (request.use_cache) {
+            JP_TRACE_BEGIN(cache_get);
+            auto cached = cache_manager->Get(job.cache_key);
+            JP_TRACE_END(cache_get, "cache_get");
+            if (cached) {
+                result = *cached;
+                result.stats.cache_hit = true;
+                return false;
+            }
+        }
+
+        // Pre-tokenized input goes straight to inference
+        if (request.token_ids.has_value()) {
+            job.tokens = *request.token_ids;
+            result.stats.token_count = job.tokens.size();
+            if (HasDiagnostics(request.diagnostics, Diagnostics::TOKENS)) {
+                result.diagnostics.token_ids = job.tokens;
+            }
+            return ResolveVoice(job);
+        }
+
+        // Step 1-2: Text normalization and phonemization
+        auto phoneme_start = std::chrono::high_resolution_clock::now();
+        std::string phonemes;
+
+        if (request.ipa_phonemes.has_value()) {
+            // Use provided phonemes; the text is not needed
+            phonemes = *request.ipa_phonemes;
+        } else {
+            std::string normalized_text = request.normalize_text ?
+                                         snap.phonemizer->NormalizeText(request.text) : request.text;
+            JP_TRACE_SCOPE("phonemize");
+            phonemes = snap.phonemizer->Phonemize(normalized_text);
+        }
+
+        auto phoneme_end = std::chrono::high_resolution_clock::now();
+        result.stats.phonemization_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+            phoneme_end - phoneme_start);
+        latency.phonemization.Record(std::chrono::duration_cast<std::chrono::microseconds>(
+            phoneme_end - phoneme_start));
+
+        // Count phonemes without splitting them; the breakdown is only
+        // kept when the caller asked for it
+        result.stats.phoneme_count = ResultDiagnostics::IndexPhonemes(phonemes, nullptr);
+
+        if (StopIfCancelled(job)) {
+            return false;
+        }
+
+        // Step 3: Tokenization
+        auto token_start = std::chrono::high_resolution_clock::now();
+        {
+            JP_TRACE_SCOPE("tokenize");
+            job.tokens = snap.tokenizer->PhonemesToTokens(phonemes);
+        }
+
+        auto token_end = std::chrono::high_resolution_clock::now();
+        result.stats.tokenization_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+            token_end - token_start);
+        latency.tokenization.Record(std::chrono::duration_cast<std::chrono::microseconds>(
+            token_end - token_start));
+        result.stats.token_count = job.tokens.size();
+
+        if (HasDiagnostics(request.diagnostics, Diagnostics::PHONEMES)) {
+            result.diagnostics.SetPhonemes(std::move(phonemes));
+        }
+        if (HasDiagnostics(request.diagnostics, Diagnostics::TOKENS)) {
+            result.diagnostics.token_ids = job.tokens;
+        }
+
+        // Step 4: Get voice
+        return ResolveVoice(job);
+    }
+
+    static bool ResolveVoice(SynthesisJob& job) {
+        job.voice = job.snapshot->voice_manager->GetVoice(job.request.voice_id);
+        if (!job.voice) {
+            job.result.status = Status::ERROR_INVALID_INPUT;
+            job.result.error_message = "Voice not found: " + job.request.voice_id;
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Stage 2: ONNX inference
+     * @return false if the job is already complete
+     */
+    bool RunInferenceStage(SynthesisJob& job) {
+        if (StopIfCancelled(job)) {
+            return false;
+        }
+
+        if (!job.tier_chosen && !ChooseTier(job)) {
+            return false;
+        }
+        const ModelTier& tier = job.snapshot->tiers[job.tier];
+
+        auto inference_start = std::chrono::high_resolution_clock::now();
+
+        JP_TRACE_BEGIN(inference);
+        job.raw_audio = RunChunkedInference(
+            *job.snapshot,
+            tier,
+            job.tokens,
+            job.voice->style_vector,
+            job.request.speed * job.voice->default_speed,
+            job.request.pitch * job.voice->default_pitch,
+            job.request.cancellation.get()
+        );
+
+        JP_TRACE_END(inference, "inference");
+
+        // An aborted run returns partial or no audio; do not time or cache it
+        if (StopIfCancelled(job)) {
+            job.raw_audio.clear();
+            return false;
+        }
+
+        auto inference_end = std::chrono::high_resolution_clock::now();
+        job.result.stats.inference_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+            inference_end - inference_start);
+        latency.inference.Record(std::chrono::duration_cast<std::chrono::microseconds>(
+            inference_end - inference_start));
+
+        if (!job.tokens.empty()) {
+            double sample = std::chrono::duration<double, std::micro>(
+                inference_end - inference_start).count() / job.tokens.size();
+            UpdateInferenceEstimate(tier, sample);
+        }
+
+        return true;
+    }
+
+    // ==========================================
+    // Model Tiers
+    // ==========================================
+
+    /**
+     * @brief Pick the model tier for a request
+     *
+     * @details AUTO requests step down one tier for every
+     * tier_step_queue_depth requests waiting in the scheduler, then keep
+     * stepping down while the tier's estimated inference time would miss
+     * the deadline. HIGHEST always gets the primary model and FASTEST the
+     * last tier.
+     */
+    size_t SelectTier(const SynthesisJob& job) const {
+        const EngineSnapshot& snap = *job.snapshot;
+        size_t fastest = snap.tiers.size() - 1;
+
+        switch (job.request.quality) {
+            case QualityHint::HIGHEST:
+                return 0;
+            case QualityHint::FASTEST:
+                return fastest;
+            case QualityHint::AUTO:
+                break;
+        }
+
+        size_t tier = 0;
+        size_t step = snap.config.tier_step_queue_depth;
+        if (step > 0 && scheduler) {
+            tier = std::min(fastest, scheduler->GetQueueSize() / step);
+        }
+
+        if (job.request.deadline.has_value()) {
+            auto now = std::chrono::steady_clock::now();
+            while (tier < fastest &&
+                   now + EstimateInference(snap.tiers[tier], job.tokens.size()) >= *job.request.deadline) {
+                tier++;
+            }
+        }
+        return tier;
+    }
+
+    /**
+     * @brief Assign the job its tier, shedding it if even that one is too slow
+     * @return false if the request cannot complete before its deadline
+     */
+    bool ChooseTier(SynthesisJob& job) const {
+        // The token count is known now, so the tier can account for it
+        job.tier = SelectTier(job);
+        job.tier_chosen = true;
+        const ModelTier& tier = job.snapshot->tiers[job.tier];
+        job.result.stats.model_tier = tier.name;
+
+        if (job.request.deadline.has_value()) {
+            auto estimate = EstimateInference(tier, job.tokens.size());
+            if (std::chrono::steady_clock::now() + estimate >= *job.request.deadline) {
+                job.result.status = Status::ERROR_TIMEOUT;
+                job.result.error_message = "Request cannot complete before its deadline";
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static std::chrono::microseconds EstimateInference(const ModelTier& tier, size_t tokens) {
+        return std::chrono::microseconds(static_cast<int64_t>(tier.us_per_token->load() * tokens));
+    }
+
+    /**
+     * @brief Stage 3: audio post-processing and cache update
+     * @return false once the job is complete
+     */
+    bool RunPostProcess(SynthesisJob& job) {
+        const TTSConfig& cfg = job.snapshot->config;
+        const TTSRequest& request = job.request;
+        TTSResult& result = job.result;
+
+        JP_TRACE_SCOPE("postprocess");
+        auto audio_start = std::chrono::high_resolution_clock::now();
+
+        result.audio.samples = audio_processor->ProcessAudio(
+            job.raw_audio,
+            request.volume,
+            cfg.normalize_audio
+        );
+        job.raw_audio.clear();
+
+        result.audio.sample_rate = cfg.target_sample_rate;
+        result.audio.channels = 1;
+        result.audio.duration = std::chrono::milliseconds(
+            static_cast<int64_t>(result.audio.samples.size() * 1000 / cfg.target_sample_rate)
+        );
+
+        auto audio_end = std::chrono::high_resolution_clock::now();
+        result.stats.audio_processing_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+            audio_end - audio_start);
+        latency.audio_processing.Record(std::chrono::duration_cast<std::chrono::microseconds>(
+            audio_end - audio_start));
+
+        result.stats.audio_samples = result.audio.samples.size();
+
+        // Calculate total time
+        auto end_time = std::chrono::high_resolution_clock::now();
+        result.stats.total_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+            end_time - job.start_time);
+
+        result.status = Status::OK;
+
+        // Update cache; downgraded audio must not be served to later
+        // requests that could have had the primary model
+        if (request.use_cache && job.tier == 0) {
+            JP_TRACE_SCOPE("cache_put");
+            cache_manager->Put(job.cache_key, result);
+            EnforceMemoryBudget();
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Fold one observed inference cost into the moving average
+     *
+     * @details Concurrent updates may overwrite each other; losing the odd
+     * sample is harmless for an estimate.
+     */
+    static void UpdateInferenceEstimate(const ModelTier& tier, double us_per_token) {
+        constexpr double kAlpha = 0.1;
+        double previous = tier.us_per_token->load();
+        double updated = previous == 0.0 ? us_per_token :
+                         previous + kAlpha * (us_per_token - previous);
+        tier.us_per_token->store(updated);
+    }
+
+    // ==========================================
+    // Stage Pipeline
+    // ==========================================
+
+    /**
+     * @brief Start front-end, inference and post-processing stages
+     */
+    void StartPipeline() {
+        AddStage("frontend", config.pipeline_frontend_workers,
+                 [this](SynthesisJob& job) { return RunFrontEnd(job); });
+        AddStage("inference", config.pipeline_inference_workers,
+                 [this](SynthesisJob& job) { return RunInferenceStage(job); });
+        AddStage("postprocess", config.pipeline_postprocess_workers,
+                 [this](SynthesisJob& job) { return RunPostProcess(job); });
+
+        for (size_t i = 0; i < pipeline_stages.size(); i++) {
+            auto& stage = *pipeline_stages[i];
+            for (auto& worker : stage.workers) {
+                worker = std::thread([this, i]() { StageWorker(i); });
+            }
+        }
+    }
+
+    void AddStage(const std::string& name, int workers,
+                  std::function<bool(SynthesisJob&)> run) {
+        auto stage = std::make_unique<PipelineStage>();
+        stage->name = name;
+        stage->run = std::move(run);
+        stage->queue = std::make_unique<BoundedQueue<JobPtr>>(config.pipeline_queue_depth);
+        stage->workers.resize(std::max(1, workers));
+        pipeline_stages.push_back(std::move(stage));
+    }
+
+    /**
+     * @brief Worker loop: run this stage, then hand the job downstream
+     */
+    void StageWorker(size_t index) {
+        auto& stage = *pipeline_stages[index];
+
+        while (auto job = stage.queue->Pop()) {
+            bool forward = false;
+            auto stage_start = std::chrono::high_resolution_clock::now();
+            try {
+                forward = stage.run(**job);
+            } catch (const std::exception& e) {
+                FailJob(**job, e);
+            }
+            stage.busy_us += std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::high_resolution_clock::now() - stage_start).count();
+            stage.processed++;
+
+            // Blocks while the next stage is full, throttling this one
+            if (forward && index + 1 < pipeline_stages.size()) {
+                if (pipeline_stages[index + 1]->queue->Push(*job)) {
+                    continue;
+                }
+                (*job)->result.status = Status::ERROR_CANCELLED;
+                (*job)->result.error_message = "Engine is shutting down";
+            }
+            (*job)->completion.set_value(std::move((*job)->result));
+        }
+    }
+
+    /**
+     * @brief Drain and stop stages front to back
+     */
+    void StopPipeline() {
+        for (auto& stage : pipeline_stages) {
+            stage->queue->Close();
+            for (auto& worker : stage->workers) {
+                if (worker.joinable()) {
+                    worker.join();
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Run a single inference call, through the batcher if enabled
+     */
+    static std::vector<float> RunModel(const ModelTier& tier,
+                                       const std::vector<int>& tokens,
+                                       const std::vector<float>& style_vector,
+                                       float speed,
+                                       float pitch,
+                                       CancellationToken* cancel = nullptr) {
+        if (tier.batcher) {
+            return tier.batcher->Infer(tokens, style_vector, speed, pitch, cancel);
+        }
+        return tier.session_manager->RunInference(tokens, style_vector, speed, pitch, cancel);
+    }
+
+    /**
+     * @brief Run inference, splitting sequences over the token budget
+     *
+     * @details Chunks are cut at prosodic boundaries and run concurrently
+     * on the thread pool. The calling thread claims and runs any chunk no
+     * worker has picked up yet, so waiting here can never deadlock even
+     * when this is itself running on a pool worker.
+     */
+    std::vector<float> RunChunkedInference(const EngineSnapshot& snap,
+                                           const ModelTier& tier,
+                                           const std::vector<int>& tokens,
+                                           const std::vector<float>& style_vector,
+                                           float speed,
+                                           float pitch,
+                                           CancellationToken* cancel = nullptr) {
+        auto chunks = snap.tokenizer->ChunkTokens(tokens, snap.config.max_chunk_tokens);
+        if (chunks.size() <= 1) {
+            return RunModel(tier, tokens, style_vector, speed, pitch, cancel);
+        }
+
+        struct ChunkJob {
+            const ModelTier* tier;           // Pinned by the caller, which waits for every chunk
+            std::vector<std::vector<int>> chunks;
+            std::vector<std::vector<float>> outputs;
+            std::unique_ptr<std::atomic<bool>[]> claimed;
+            std::vector<std::promise<void>> done;
+            std::vector<float> style_vector;
+            float speed;
+            float pitch;
+            CancellationToken* cancel;       // Owned by the request, which outlives the wait
+        };
+
+        auto job = std::make_shared<ChunkJob>();
+        job->tier = &tier;
+        job->chunks = std::move(chunks);
+        job->outputs.resize(job->chunks.size());
+        job->claimed = std::make_unique<std::atomic<bool>[]>(job->chunks.size());
+        job->done.resize(job->chunks.size());
+        job->style_vector = style_vector;
+        job->speed = speed;
+        job->pitch = pitch;
+        job->cancel = cancel;
+
+        std::vector<std::future<void>> done_futures;
+        for (auto& promise : job->done) {
+            done_futures.push_back(promise.get_future());
+        }
+
+        auto run_chunk = [this](const std::shared_ptr<ChunkJob>& job, size_t i) {
+            if (job->claimed[i].exchange(true)) {
+                return;  // Already taken by another thread
+            }
+            try {
+                // Chunks not yet started are skipped once cancelled
+                if (job->cancel && job->cancel->IsCancelled()) {
+                    throw std::runtime_error("Cancelled before chunk " + std::to_string(i));
+                }
+                job->outputs[i] = RunModel(*job->tier,
+                    job->chunks[i], job->style_vector, job->speed, job->pitch, job->cancel);
+                if (job->outputs[i].empty()) {
+                    throw std::runtime_error("Inference failed for chunk " + std::to_string(i));
+                }
+                job->done[i].set_value();
+            } catch (...) {
+                job->done[i].set_exception(std::current_exception());
+            }
+        };
+
+        for (size_t i = 1; i < job->chunks.size(); i++) {
+            thread_pool->enqueue([run_chunk, job, i]() { run_chunk(job, i); });
+        }
+
+        for (size_t i = 0; i < job->chunks.size(); i++) {
+            run_chunk(job, i);
+        }
+        // Chunks claimed by pool threads may still be running with this
+        // request's token and tier, so let every one finish before any
+        // failure is rethrown and the request is torn down
+        for (auto& future : done_futures) {
+            future.wait();
+        }
+        for (auto& future : done_futures) {
+            future.get();  // Rethrows chunk failures
+        }
+
+        return audio_processor->ConcatenateWithCrossfade(job->outputs, snap.config.chunk_crossfade_ms);
+    }
+
+    /**
+     * @brief Update success/failure counters and end-to-end latency
+     *
+     * @details Only successful requests are added to the latency
+     * histogram, so fast rejections under overload do not mask the
+     * latency of the work actually served.
+     */
+    void RecordOutcome(const TTSResult& result, std::chrono::microseconds elapsed) {
+        if (result.IsSuccess()) {
+            successful_requests++;
+            latency.total.Record(elapsed);
+        } else {
+            failed_requests++;
+        }
+    }
+
+    /**
+     * @brief Microseconds elapsed since a start time
+     */
+    static std::chrono::microseconds ElapsedMicros(
+        std::chrono::high_resolution_clock::time_point start) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::high_resolution_clock::now() - start);
+    }
+
+    /**
+     * @brief Synthesize sentence by sentence, delivering each chunk early
+     *
+     * @details With a split model each sentence is further delivered one
+     * vocoder window at a time, so even a single long sentence starts
+     * playing before it has been fully vocoded.
+     */
+    TTSResult ProcessStream(const TTSRequest& request, const AudioChunkCallback& on_chunk) {
+        TTSResult result;
+        auto start_time = std::chrono::high_resolution_clock::now();
+
+        // Every segment uses the same components, even across a reload
+        SnapshotPtr snap = CurrentSnapshot();
+
+        // Pre-computed phonemes cannot be re-aligned with the text, so they
+        // are synthesized as a single chunk
+        std::vector<std::string> segments;
+        if (request.ipa_phonemes.has_value() || request.token_ids.has_value()) {
+            segments.push_back(request.text);
+        } else {
+            segments = StringUtils::SplitSentences(request.text, snap->config.stream_min_clause_chars);
+        }
+
+        if (segments.empty()) {
+            result.status = Status::ERROR_INVALID_INPUT;
+            result.error_message = "No text to synthesize";
+            RecordOutcome(result, ElapsedMicros(start_time));
+            return result;
+        }
+
+        std::vector<float> samples;
+        result.audio.sample_rate = snap->config.target_sample_rate;
+        result.audio.channels = 1;
+        result.stats.text_length = request.text.length();
 
-    // Callbacks
-    ProgressCallback progress_callback;
-    ErrorCallback error_callback;
+        for (size_t i = 0; i < segments.size(); i++) {
+            TTSRequest segment_request = request;
+            segment_request.text = segments[i];
 
-    // Performance tracking
-    std::vector<std::chrono::milliseconds> latency_history;
-    std::mutex stats_mutex;
+            bool last_segment = (i + 1 == segments.size());
+            auto deliver = [&](const AudioData& chunk, bool last_of_segment) {
+                if (on_chunk) {
+                    on_chunk(chunk, result.stats.chunk_count, last_segment && last_of_segment);
+                }
+                if (result.stats.chunk_count == 0) {
+                    result.stats.first_chunk_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::high_resolution_clock::now() - start_time);
+                }
+                result.stats.chunk_count++;
+                samples.insert(samples.end(), chunk.samples.begin(), chunk.samples.end());
+            };
+
+            TTSResult segment = StreamSegment(segment_request, snap, deliver);
+            if (!segment.IsSuccess()) {
+                result.status = segment.status;
+                result.error_message = segment.error_message;
+                break;
+            }
 
-    // Last error message
-    std::string last_error;
+            // Aggregate phonemes and stage timings
+            result.diagnostics.Append(segment.diagnostics);
+
+            result.stats.phonemization_time += segment.stats.phonemization_time;
+            result.stats.tokenization_time += segment.stats.tokenization_time;
+            result.stats.inference_time += segment.stats.inference_time;
+            result.stats.audio_processing_time += segment.stats.audio_processing_time;
+            result.stats.phoneme_count += segment.stats.phoneme_count;
+            result.stats.token_count += segment.stats.token_count;
+            result.stats.cache_hit = (i == 0 || result.stats.cache_hit) && segment.stats.cache_hit;
+            if (!segment.stats.model_tier.empty()) {
+                result.stats.model_tier = segment.stats.model_tier;  // Last tier used
+            }
+        }
 
-    /**
-     * @brief Constructor
-     */
-    Impl(const TTSConfig& cfg) : config(cfg) {
-        // Initialize components
-        session_manager = std::make_unique<SessionManager>();
-        voice_manager = std::make_unique<VoiceManager>();
-        cache_manager = std::make_unique<CacheManager>(config.max_cache_size_mb * 1024 * 1024);
+        result.audio.samples = std::move(samples);
+        result.audio.duration = std::chrono::milliseconds(
+            static_cast<int64_t>(result.audio.samples.size() * 1000 / snap->config.target_sample_rate));
+        result.stats.audio_samples = result.audio.samples.size();
+        result.stats.total_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::high_resolution_clock::now() - start_time);
 
-        // Create thread pool for parallel processing
-        int num_threads = config.max_concurrent_requests > 0 ?
-                         config.max_concurrent_requests : std::thread::hardware_concurrency();
-        thread_pool = std::make_unique<ThreadPool>(num_threads);
+        RecordOutcome(result, ElapsedMicros(start_time));
+        return result;
     }
 
     /**
-     * @brief Destructor
+     * @brief Synthesize one stream segment, delivering audio as it is vocoded
+     *
+     * @details With a split model the acoustic model runs once and each
+     * vocoder window is handed to deliver as soon as it is done. Windows
+     * get the request's volume but not peak normalization, which needs
+     * the whole segment, so windowed segments are not cached either.
+     * Single-graph models, cache hits, segments over the token budget
+     * and segments downgraded to a faster (single-graph) tier are
+     * delivered whole.
+     *
+     * @param deliver Receives each piece of audio and whether it ends the segment
      */
-    ~Impl() {
-        // Stop queue processing
-        stop_processing = true;
-        queue_cv.notify_all();
-        if (queue_processor.joinable()) {
-            queue_processor.join();
+    TTSResult StreamSegment(const TTSRequest& request, const SnapshotPtr& snap,
+                            const std::function<void(const AudioData&, bool)>& deliver) {
+        auto deliver_whole = [&](TTSResult result) {
+            if (result.IsSuccess()) {
+                deliver(result.audio, true);
+            }
+            return result;
+        };
+
+        if (!snap->session_manager->HasVocoder()) {
+            return deliver_whole(SynthesizeText(request, snap));
         }
-    }
 
-    /**
-     * @brief Initialize all components
-     */
-    Status Initialize() {
+        SynthesisJob job;
+        job.request = request;
+        job.cache_key = GenerateCacheKey(request, snap->version);
+        job.snapshot = snap;
+        job.start_time = std::chrono::high_resolution_clock::now();
+        TTSResult& result = job.result;
+
         try {
-            // Initialize ONNX session for Kokoro model
-            if (!session_manager->LoadModel(config.kokoro_model_path)) {
-                last_error = "Failed to load Kokoro model from: " + config.kokoro_model_path;
-                return Status::ERROR_MODEL_NOT_LOADED;
+            if (!RunFrontEnd(job)) {
+                // Cache hit or error
+                return deliver_whole(std::move(result));
             }
 
-            // Initialize phonemizer
-            JapanesePhonemizer::Config phonemizer_config;
-            phonemizer_config.dictionary_path = config.dictionary_path;
-            phonemizer_config.onnx_model_path = config.phonemizer_model_path;
-            phonemizer_config.use_mecab = config.enable_mecab;
-            phonemizer_config.enable_cache = config.enable_cache;
-
-            phonemizer = std::make_unique<JapanesePhonemizer>(phonemizer_config);
-            auto status = phonemizer->Initialize();
-            if (status != Status::OK) {
-                last_error = "Failed to initialize phonemizer";
-                return status;
+            // Tiering and deadline shedding apply as for whole requests
+            if (!ChooseTier(job)) {
+                return deliver_whole(std::move(result));
             }
 
-            // Initialize tokenizer
-            tokenizer = std::make_unique<IPATokenizer>();
-            if (!tokenizer->LoadVocabulary(config.tokenizer_vocab_path)) {
-                last_error = "Failed to load tokenizer vocabulary from: " + config.tokenizer_vocab_path;
-                return Status::ERROR_FILE_NOT_FOUND;
+            // Only the primary model is split, so faster tiers and chunked
+            // input are synthesized whole
+            if (job.tier != 0 || job.tokens.size() > snap->config.max_chunk_tokens) {
+                if (RunInferenceStage(job)) {
+                    RunPostProcess(job);
+                }
+                return deliver_whole(std::move(result));
             }
 
-            // Initialize audio processor
-            audio_processor = std::make_unique<AudioProcessor>(config.target_sample_rate);
-
-            // Load default voices
-            LoadVoicesFromDirectory(config.voices_dir);
+            AudioData window;
+            window.sample_rate = snap->config.target_sample_rate;
+            window.channels = 1;
 
-            // Start queue processor thread
-            queue_processor = std::thread(&Impl::ProcessQueue, this);
+            auto inference_start = std::chrono::high_resolution_clock::now();
+            bool complete = snap->session_manager->RunStreamingInference(
+                job.tokens,
+                job.voice->style_vector,
+                request.speed * job.voice->default_speed,
+                request.pitch * job.voice->default_pitch,
+                [&](std::vector<float> samples, bool is_last) {
+                    window.samples = audio_processor->ProcessAudio(samples, request.volume, false);
+                    window.duration = std::chrono::milliseconds(static_cast<int64_t>(
+                        window.samples.size() * 1000 / window.sample_rate));
+                    result.stats.audio_samples += window.samples.size();
+                    deliver(window, is_last);
+                },
+                request.cancellation.get());
+
+            if (StopIfCancelled(job)) {
+                return std::move(result);
+            }
+            if (!complete) {
+                result.status = Status::ERROR_INFERENCE_FAILED;
+                result.error_message = "Vocoder streaming failed";
+                return std::move(result);
+            }
 
-            initialized = true;
-            return Status::OK;
+            auto end_time = std::chrono::high_resolution_clock::now();
+            result.stats.inference_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+                end_time - inference_start);
+            result.stats.total_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+                end_time - job.start_time);
+            result.status = Status::OK;
 
         } catch (const std::exception& e) {
-            last_error = std::string("Initialization error: ") + e.what();
-            return Status::ERROR_INVALID_INPUT;
+            FailJob(job, e);
         }
+        return std::move(result);
     }
 
     /**
-     * @brief Load voices from directory
+     * @brief Queue a request on the scheduler
+     *
+     * @param request Synthesis request
+     * @param on_done Receives the result once synthesis finishes
+     * @return Request ID
      */
-    void LoadVoicesFromDirectory(const std::string& dir) {
-        namespace fs = std::filesystem;
+    std::string ScheduleRequest(const TTSRequest& request,
+                                std::function<void(TTSResult)> on_done) {
+        std::string id = GenerateRequestId();
+        auto queue_position = std::make_shared<size_t>(0);  // Set by Submit before run can start
+        JP_TRACE_BEGIN(queue_wait);
+
+        size_t request_bytes = RequestBytes(request);
+        queued_request_bytes += request_bytes;
+
+        // Every scheduled request gets a token so CancelRequest can stop it
+        TTSRequest scheduled = request;
+        if (!scheduled.cancellation) {
+            scheduled.cancellation = std::make_shared<CancellationToken>();
+        }
+        {
+            std::lock_guard<std::mutex> lock(request_tokens_mutex);
+            request_tokens[id] = scheduled.cancellation;
+        }
 
-        if (!fs::exists(dir)) {
-            return;
+        auto run = [=]() {
+            JP_TRACE_END(queue_wait, "queue_wait");
+            queued_request_bytes -= request_bytes;
+            total_requests++;
+            active_synthesis_count++;
+            TTSResult result = ProcessSynthesis(scheduled);
+            active_synthesis_count--;
+            ForgetToken(id);
+
+            result.stats.queue_position = static_cast<int>(*queue_position);
+            on_done(std::move(result));
+        };
+
+        auto on_cancel = [this, on_done, request_bytes, id]() {
+            queued_request_bytes -= request_bytes;
+            ForgetToken(id);
+            TTSResult result;
+            result.status = Status::ERROR_CANCELLED;
+            result.error_message = "Request cancelled before processing";
+            on_done(std::move(result));
+        };
+
+        // Reject fast rather than queueing work that is already late or
+        // that would wait behind a full backlog
+        bool expired = DeadlinePassed(request);
+        std::optional<size_t> position;
+        if (!expired) {
+            position = scheduler->Submit(id, request.priority, run, on_cancel, queue_position.get());
         }
 
-        for (const auto& entry : fs::directory_iterator(dir)) {
-            if (entry.path().extension() == ".json") {
-                voice_manager->LoadVoice(entry.path().string());
-            }
+        if (!position) {
+            queued_request_bytes -= request_bytes;
+            ForgetToken(id);
+            TTSResult result = expired ?
+                MakeErrorResult(Status::ERROR_TIMEOUT, "Deadline passed before request was queued") :
+                MakeErrorResult(Status::ERROR_QUEUE_FULL, "Request queue is full");
+            total_requests++;
+            RecordOutcome(result, std::chrono::microseconds(0));
+            on_done(std::move(result));
+            return id;
         }
+
+        EnforceMemoryBudget();
+        return id;
+    }
+
+    void ForgetToken(const std::string& id) {
+        std::lock_guard<std::mutex> lock(request_tokens_mutex);
+        request_tokens.erase(id);
     }
 
     /**
-     * @brief Process synthesis request
+     * @brief Drop a queued request or signal a running one
      */
-    TTSResult ProcessSynthesis(const TTSRequest& request) {
-        TTSResult result;
-        auto start_time = std::chrono::high_resolution_clock::now();
-
-        try {
-            // Update statistics
-            result.stats.text_length = request.text.length();
+    bool CancelScheduled(const std::string& id) {
+        if (scheduler && scheduler->Cancel(id)) {
+            return true;
+        }
 
-            // Check cache first
-            std::string cache_key = GenerateCacheKey(request);
-            if (request.use_cache) {
-                auto cached = cache_manager->Get(cache_key);
-                if (cached) {
-                    result = *cached;
-                    result.stats.cache_hit = true;
-                    return result;
-                }
+        std::shared_ptr<CancellationToken> token;
+        {
+            std::lock_guard<std::mutex> lock(request_tokens_mutex);
+            auto it = request_tokens.find(id);
+            if (it == request_tokens.end()) {
+                return false;
             }
+            token = it->second;
+        }
+        return token->Cancel();
+    }
 
-            // Step 1: Text normalization
-            std::string normalized_text = request.normalize_text ?
-                                         phonemizer->NormalizeText(request.text) : request.text;
-
-            // Step 2: Phonemization
-            auto phoneme_start = std::chrono::high_resolution_clock::now();
-            std::string phonemes;
+    static size_t RequestBytes(const TTSRequest& request) {
+        size_t bytes = sizeof(TTSRequest) + request.text.capacity() + request.voice_id.capacity();
+        if (request.ipa_phonemes) {
+            bytes += request.ipa_phonemes->capacity();
+        }
+        return bytes;
+    }
 
-            if (request.ipa_phonemes.has_value()) {
-                // Use provided phonemes
-                phonemes = *request.ipa_phonemes;
+    // ==========================================
+    // Memory Accounting
+    // ==========================================
+
+    // Voices unused this long may be released under memory pressure
+    static constexpr std::chrono::seconds kVoiceIdleTime{60};
+
+    // Shrinks take effect one run later, so asking on every cache Put
+    // while over budget would only add work
+    static constexpr std::chrono::seconds kArenaShrinkInterval{1};
+
+    TTSEngine::MemoryUsage MeasureMemory() const {
+        SnapshotPtr snap = CurrentSnapshot();
+
+        // Every tier allocates from the process-wide arena, so a measured
+        // arena counts once; the per-tier fallback estimates do not overlap
+        TTSEngine::MemoryUsage usage{};
+        size_t shared_arena = 0;
+        for (const auto& tier : snap->tiers) {
+            auto stats = tier.session_manager->GetStats();
+            usage.session_bytes += stats.model_bytes;
+            if (stats.arena_measured) {
+                shared_arena = std::max(shared_arena, stats.arena_bytes);
             } else {
-                // Generate phonemes
-                phonemes = phonemizer->Phonemize(normalized_text);
+                usage.session_bytes += stats.arena_bytes;
             }
+        }
+        usage.session_bytes += shared_arena;
+        usage.cache_bytes = cache_manager->GetCurrentSize();
+        usage.dictionary_bytes = snap->dictionary_bytes;
+        usage.voice_bytes = snap->voice_manager->GetMemoryUsage();
+        usage.queued_bytes = queued_request_bytes.load();
+        usage.total_bytes = usage.session_bytes + usage.cache_bytes + usage.dictionary_bytes +
+                            usage.voice_bytes + usage.queued_bytes;
+        usage.budget_bytes = max_memory_bytes.load();
+        return usage;
+    }
 
-            auto phoneme_end = std::chrono::high_resolution_clock::now();
-            result.stats.phonemization_time = std::chrono::duration_cast<std::chrono::milliseconds>(
-                phoneme_end - phoneme_start);
-
-            // Parse phonemes for result
-            result.phonemes = ParsePhonemes(phonemes);
-            result.stats.phoneme_count = result.phonemes.size();
-
-            // Step 3: Tokenization
-            auto token_start = std::chrono::high_resolution_clock::now();
-            std::vector<int> tokens = tokenizer->PhonemesToTokens(phonemes);
-
-            auto token_end = std::chrono::high_resolution_clock::now();
-            result.stats.tokenization_time = std::chrono::duration_cast<std::chrono::milliseconds>(
-                token_end - token_start);
-            result.stats.token_count = tokens.size();
-
-            // Step 4: Get voice
-            auto voice = voice_manager->GetVoice(request.voice_id);
-            if (!voice) {
-                result.status = Status::ERROR_INVALID_INPUT;
-                result.error_message = "Voice not found: " + request.voice_id;
-                return result;
-            }
-
-            // Step 5: ONNX inference
-            auto inference_start = std::chrono::high_resolution_clock::now();
-
-            auto audio_samples = session_manager->RunInference(
-                tokens,
-                voice->style_vector,
-                request.speed * voice->default_speed,
-                request.pitch * voice->default_pitch
-            );
+    /**
+     * @brief Shed memory until usage fits the budget
+     *
+     * @details Cheapest to rebuild first: cached results, then idle
+     * voices, then the inference arena.
+     */
+    void EnforceMemoryBudget() {
+        size_t budget = max_memory_bytes.load();
+        if (budget == 0) {
+            return;
+        }
 
-            auto inference_end = std::chrono::high_resolution_clock::now();
-            result.stats.inference_time = std::chrono::duration_cast<std::chrono::milliseconds>(
-                inference_end - inference_start);
+        auto usage = MeasureMemory();
+        if (usage.total_bytes <= budget) {
+            return;
+        }
 
-            // Step 6: Audio post-processing
-            auto audio_start = std::chrono::high_resolution_clock::now();
+        size_t excess = usage.total_bytes - budget;
+        size_t freed = cache_manager->TrimTo(
+            usage.cache_bytes > excess ? usage.cache_bytes - excess : 0);
+        if (freed >= excess) {
+            return;
+        }
+        excess -= freed;
 
-            result.audio.samples = audio_processor->ProcessAudio(
-                audio_samples,
-                request.volume,
-                config.normalize_audio
-            );
+        freed = CurrentSnapshot()->voice_manager->ReleaseIdleVoices(kVoiceIdleTime);
+        if (freed >= excess) {
+            return;
+        }
 
-            result.audio.sample_rate = config.target_sample_rate;
-            result.audio.channels = 1;
-            result.audio.duration = std::chrono::milliseconds(
-                static_cast<int64_t>(result.audio.samples.size() * 1000 / config.target_sample_rate)
-            );
+        auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+        auto last = last_arena_shrink.load();
+        auto interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            kArenaShrinkInterval).count();
+        if (now - last < interval || !last_arena_shrink.compare_exchange_strong(last, now)) {
+            return;
+        }
+        for (const auto& tier : CurrentSnapshot()->tiers) {
+            tier.session_manager->ShrinkArena();
+        }
+    }
 
-            auto audio_end = std::chrono::high_resolution_clock::now();
-            result.stats.audio_processing_time = std::chrono::duration_cast<std::chrono::milliseconds>(
-                audio_end - audio_start);
+    /**
+     * @brief Run many requests across the thread pool
+     *
+     * @details Identical cacheable requests are synthesized once and
+     * cache hits are answered before any work is queued. The remaining
+     * unique requests run longest-first from a shared cursor, so similar
+     * lengths land in the same batching window and the longest items do
+     * not start last and stretch the tail.
+     *
+     * @return One future per input, in input order
+     */
+    std::vector<std::future<TTSResult>> ProcessBatch(const std::vector<TTSRequest>& requests) {
+        struct BatchWork {
+            std::vector<TTSRequest> requests;             // Unique requests to run
+            std::vector<std::vector<size_t>> targets;     // Input indices per unique request
+            std::vector<size_t> order;                    // Execution order into requests
+            std::vector<std::promise<TTSResult>> promises; // One per input
+            SnapshotPtr snapshot;                         // Whole batch uses one snapshot
+            std::atomic<size_t> cursor{0};
+        };
+
+        auto work = std::make_shared<BatchWork>();
+        work->snapshot = CurrentSnapshot();
+        work->promises.resize(requests.size());
+
+        std::vector<std::future<TTSResult>> futures;
+        futures.reserve(requests.size());
+        for (auto& promise : work->promises) {
+            futures.push_back(promise.get_future());
+        }
 
-            result.stats.audio_samples = result.audio.samples.size();
+        // Deduplicate on the cache key and quality hint; uncacheable
+        // requests always run
+        std::unordered_map<std::string, size_t> unique_index;
+        for (size_t i = 0; i < requests.size(); i++) {
+            if (requests[i].use_cache) {
+                std::string key = GenerateCacheKey(requests[i], work->snapshot->version);
+                std::string shared_key = CoalescingKey(requests[i], key);
+                auto found = unique_index.find(shared_key);
+                if (found != unique_index.end()) {
+                    work->targets[found->second].push_back(i);
+                    continue;
+                }
 
-            // Calculate total time
-            auto end_time = std::chrono::high_resolution_clock::now();
-            result.stats.total_time = std::chrono::duration_cast<std::chrono::milliseconds>(
-                end_time - start_time);
+                // Answer cache hits without queueing anything
+                auto start_time = std::chrono::high_resolution_clock::now();
+                auto cached = cache_manager->Get(key);
+                if (cached) {
+                    TTSResult result = *cached;
+                    result.stats.cache_hit = true;
+                    total_requests++;
+                    RecordOutcome(result, ElapsedMicros(start_time));
+                    work->promises[i].set_value(std::move(result));
+                    continue;
+                }
 
-            // Update cache
-            if (request.use_cache) {
-                cache_manager->Put(cache_key, result);
+                unique_index.emplace(std::move(shared_key), work->requests.size());
             }
+            work->requests.push_back(requests[i]);
+            work->targets.push_back({i});
+        }
 
-            // Update statistics
-            successful_requests++;
-            result.status = Status::OK;
-
-        } catch (const std::exception& e) {
-            result.status = Status::ERROR_INFERENCE_FAILED;
-            result.error_message = e.what();
-            failed_requests++;
+        // Longest first
+        std::vector<size_t> estimated_tokens(work->requests.size());
+        for (size_t u = 0; u < work->requests.size(); u++) {
+            estimated_tokens[u] = EstimateTokenCount(work->requests[u]);
+            work->order.push_back(u);
         }
+        std::stable_sort(work->order.begin(), work->order.end(), [&](size_t a, size_t b) {
+            return estimated_tokens[a] > estimated_tokens[b];
+        });
+
+        auto run_batch = [this, work]() {
+            size_t next;
+            while ((next = work->cursor.fetch_add(1)) < work->order.size()) {
+                size_t u = work->order[next];
+                const auto& targets = work->targets[u];
+
+                if (shutting_down) {
+                    TTSResult result = MakeErrorResult(Status::ERROR_CANCELLED,
+                                                       "Engine shut down before processing");
+                    for (size_t target : targets) {
+                        work->promises[target].set_value(result);
+                    }
+                    continue;
+                }
 
-        // Track latency
-        {
-            std::lock_guard<std::mutex> lock(stats_mutex);
-            latency_history.push_back(result.stats.total_time);
-            if (latency_history.size() > 1000) {
-                latency_history.erase(latency_history.begin());
+                auto start_time = std::chrono::high_resolution_clock::now();
+                total_requests++;
+                TTSResult result = ProcessSynthesis(work->requests[u], work->snapshot);
+                auto elapsed = ElapsedMicros(start_time);
+
+                // Duplicates share the result and count as served from cache
+                for (size_t t = 1; t < targets.size(); t++) {
+                    TTSResult shared = result;
+                    shared.stats.cache_hit = true;
+                    total_requests++;
+                    RecordOutcome(shared, elapsed);
+                    work->promises[targets[t]].set_value(std::move(shared));
+                }
+                work->promises[targets[0]].set_value(std::move(result));
             }
+        };
+
+        size_t num_tasks = std::min(thread_pool->size(), work->order.size());
+        for (size_t t = 0; t < num_tasks; t++) {
+            thread_pool->enqueue(run_batch);
         }
 
-        return result;
+        return futures;
+    }
+
+    /**
+     * @brief Rough token count used to order batch work
+     */
+    static size_t EstimateTokenCount(const TTSRequest& request) {
+        // Japanese text averages about two phonemes per character
+        constexpr size_t kPhonemesPerChar = 2;
+        if (request.token_ids.has_value()) {
+            return request.token_ids->size();
+        }
+        if (request.ipa_phonemes.has_value()) {
+            return StringUtils::UTF8ToUTF32(*request.ipa_phonemes).size();
+        }
+        return StringUtils::UTF8ToUTF32(request.text).size() * kPhonemesPerChar;
     }
 
     /**
-     * @brief Process request queue
+     * @brief Sweep token lengths and voices to reach steady state
+     *
+     * @param snap Components to warm; may not be published yet
      */
-    void ProcessQueue() {
-        while (!stop_processing) {
-            std::unique_lock<std::mutex> lock(queue_mutex);
+    Status RunWarmup(const SnapshotPtr& snap) {
+        std::vector<std::vector<float>> styles;
+        for (const auto& voice : snap->voice_manager->GetAllVoices()) {
+            styles.push_back(voice.style_vector);
+        }
+        if (styles.empty()) {
+            styles.emplace_back(snap->session_manager->GetStyleDim(), 0.5f);
+        }
+
+        // Real phoneme IDs exercise the same embedding rows as requests
+        std::vector<int> pattern = snap->tokenizer->PhonemesToTokens("koɴɲitɕiwa sekai");
+        if (pattern.empty()) {
+            pattern.push_back(1);
+        }
 
-            // Wait for requests or stop signal
-            queue_cv.wait(lock, [this] {
-                return !request_queue.empty() || stop_processing;
-            });
+        std::vector<TTSEngine::WarmupStats> report;
+        Status status = Status::OK;
 
-            if (stop_processing) break;
+        for (size_t length : WarmupLengths(snap->config)) {
+            std::vector<int> tokens(length);
+            for (size_t i = 0; i < length; i++) {
+                tokens[i] = pattern[i % pattern.size()];
+            }
 
-            // Get next request
-            if (!request_queue.empty()) {
-                auto queued = std::move(request_queue.front());
-                request_queue.pop();
-                lock.unlock();
+            TTSEngine::WarmupStats bucket;
+            bucket.token_length = length;
 
-                // Process request
-                active_synthesis_count++;
-                auto result = ProcessSynthesis(queued.request);
-                active_synthesis_count--;
+            auto cold_start = std::chrono::high_resolution_clock::now();
+            if (RunModel(snap->tiers.front(), tokens, styles.front(), 1.0f, 1.0f).empty()) {
+                status = Status::ERROR_INFERENCE_FAILED;
+            }
+            bucket.cold_latency = ElapsedMicros(cold_start);
+
+            // Concurrent runs warm per-thread arenas and the batched shapes
+            size_t runs = std::max(styles.size(), thread_pool->size());
+            std::vector<std::future<std::chrono::microseconds>> timings;
+            for (size_t r = 0; r < runs; r++) {
+                const auto& style = styles[r % styles.size()];
+                timings.push_back(thread_pool->enqueue([&snap, &tokens, &style]() {
+                    auto start = std::chrono::high_resolution_clock::now();
+                    RunModel(snap->tiers.front(), tokens, style, 1.0f, 1.0f);
+                    return ElapsedMicros(start);
+                }));
+            }
 
-                // Fulfill promise
-                queued.promise.set_value(result);
+            std::vector<std::chrono::microseconds> warm;
+            for (auto& timing : timings) {
+                warm.push_back(timing.get());
+            }
+            std::nth_element(warm.begin(), warm.begin() + warm.size() / 2, warm.end());
+            bucket.warm_latency = warm[warm.size() / 2];
+            bucket.warm_runs = runs;
+
+            if (snap->config.verbose) {
+                std::cout << "Warmup " << length << " tokens: cold "
+                          << bucket.cold_latency.count() / 1000.0 << " ms, warm "
+                          << bucket.warm_latency.count() / 1000.0 << " ms ("
+                          << runs << " runs)" << std::endl;
+            }
+            report.push_back(bucket);
+        }
 
-                // Call callback if provided
-                if (queued.callback && result.IsSuccess()) {
-                    queued.callback(result.audio);
-                }
+        // Faster tiers only need their kernels and arenas set up
+        std::vector<size_t> lengths = WarmupLengths(snap->config);
+        for (size_t t = 1; t < snap->tiers.size(); t++) {
+            if (!snap->tiers[t].session_manager->Warmup(lengths)) {
+                status = Status::ERROR_INFERENCE_FAILED;
             }
         }
+
+        // Warmup runs should not show up in serving statistics
+        for (const auto& tier : snap->tiers) {
+            tier.session_manager->ResetStats();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(warmup_mutex);
+            warmup_report = std::move(report);
+        }
+        return status;
+    }
+
+    /**
+     * @brief Generate a unique request ID
+     */
+    std::string GenerateRequestId() {
+        return "req-" + std::to_string(next_request_id.fetch_add(1));
     }
 
     /**
      * @brief Generate cache key for request
+     *
+     * @details The snapshot version keeps audio from a replaced model or
+     * voice set from being served after a reload.
      */
-    std::string GenerateCacheKey(const TTSRequest& request) {
+    std::string GenerateCacheKey(const TTSRequest& request, uint64_t version) {
         std::stringstream ss;
-        ss << request.text << "|"
+        ss << version << "|";
+
+        // Pre-computed input decides the audio, not the text
+        if (request.token_ids.has_value()) {
+            ss << "t:";
+            for (int token : *request.token_ids) {
+                ss << token << ",";
+            }
+        } else if (request.ipa_phonemes.has_value()) {
+            ss << "p:" << *request.ipa_phonemes;
+        }
+
+        // Diagnostics change what the cached result carries
+        ss << "|d" << static_cast<uint32_t>(request.diagnostics);
+
+        ss << "|"
+           << request.text << "|"
            << request.voice_id << "|"
            << request.speed << "|"
            << request.pitch << "|"
@@ -358,22 +1942,15 @@ public:
     }
 
     /**
-     * @brief Parse phoneme string into structured format
+     * @brief Key for sharing one synthesis between identical requests
+     *
+     * @details Only primary-tier audio is cached, so the cache key needs
+     * no tier. Requests in flight may still be served by a faster tier,
+     * and a caller must not share audio from a tier its quality hint
+     * would not have chosen.
      */
-    std::vector<PhonemeInfo> ParsePhonemes(const std::string& phonemes) {
-        std::vector<PhonemeInfo> result;
-        std::istringstream stream(phonemes);
-        std::string phoneme;
-        int position = 0;
-
-        while (stream >> phoneme) {
-            PhonemeInfo info;
-            info.phoneme = phoneme;
-            info.position = position++;
-            result.push_back(info);
-        }
-
-        return result;
+    static std::string CoalescingKey(const TTSRequest& request, const std::string& cache_key) {
+        return cache_key + "|q" + std::to_string(static_cast<int>(request.quality));
     }
 };
 
@@ -398,19 +1975,42 @@ bool TTSEngine::IsInitialized() const {
 }
 
 Status TTSEngine::UpdateConfig(const TTSConfig& config) {
-    pImpl->config = config;
-    // Some settings might require re-initialization
-    return Status::OK;
+    {
+        std::lock_guard<std::mutex> lock(pImpl->reload_mutex);
+        if (!pImpl->initialized) {
+            pImpl->config = config;
+            auto updated = std::make_shared<Impl::EngineSnapshot>(*pImpl->CurrentSnapshot());
+            updated->config = config;
+            pImpl->PublishSnapshot(std::move(updated));
+            return Status::OK;
+        }
+    }
+    return ReloadAsync(config).get();
+}
+
+std::future<Status> TTSEngine::ReloadAsync(const TTSConfig& config) {
+    if (!pImpl->initialized) {
+        std::promise<Status> not_ready;
+        not_ready.set_value(Status::ERROR_NOT_INITIALIZED);
+        return not_ready.get_future();
+    }
+    // Impl stays put when the engine is moved; the engine object does not
+    Impl* impl = pImpl.get();
+    return std::async(std::launch::async, [impl, config]() {
+        return impl->Reload(config);
+    });
 }
 
-const TTSConfig& TTSEngine::GetConfig() const {
-    return pImpl->config;
+TTSConfig TTSEngine::GetConfig() const {
+    // The snapshot's configuration is immutable once published
+    return pImpl->CurrentSnapshot()->config;
 }
 
 TTSResult TTSEngine::SynthesizeSimple(const std::string& text, const std::string& voice_id) {
     TTSRequest request;
     request.text = text;
-    request.voice_id = voice_id.empty() ? pImpl->voice_manager->GetDefaultVoiceId() : voice_id;
+    request.voice_id = voice_id.empty() ?
+        pImpl->CurrentSnapshot()->voice_manager->GetDefaultVoiceId() : voice_id;
     return Synthesize(request);
 }
 
@@ -426,6 +2026,46 @@ TTSResult TTSEngine::Synthesize(const TTSRequest& request) {
     return pImpl->ProcessSynthesis(request);
 }
 
+std::vector<TTSResult> TTSEngine::SynthesizeBatch(const std::vector<TTSRequest>& requests) {
+    std::vector<TTSResult> results;
+    results.reserve(requests.size());
+
+    for (auto& future : SynthesizeBatchAsync(requests)) {
+        results.push_back(future.get());
+    }
+    return results;
+}
+
+std::vector<std::future<TTSResult>> TTSEngine::SynthesizeBatchAsync(
+    const std::vector<TTSRequest>& requests) {
+    if (!pImpl->initialized) {
+        std::vector<std::future<TTSResult>> futures;
+        for (size_t i = 0; i < requests.size(); i++) {
+            std::promise<TTSResult> promise;
+            TTSResult result;
+            result.status = Status::ERROR_NOT_INITIALIZED;
+            result.error_message = "Engine not initialized";
+            promise.set_value(result);
+            futures.push_back(promise.get_future());
+        }
+        return futures;
+    }
+
+    return pImpl->ProcessBatch(requests);
+}
+
+TTSResult TTSEngine::SynthesizeStream(const TTSRequest& request, AudioChunkCallback on_chunk) {
+    if (!pImpl->initialized) {
+        TTSResult result;
+        result.status = Status::ERROR_NOT_INITIALIZED;
+        result.error_message = "Engine not initialized";
+        return result;
+    }
+
+    pImpl->total_requests++;
+    return pImpl->ProcessStream(request, on_chunk);
+}
+
 std::future<TTSResult> TTSEngine::SynthesizeAsync(const TTSRequest& request) {
     auto promise = std::make_shared<std::promise<TTSResult>>();
     auto future = promise->get_future();
@@ -438,48 +2078,258 @@ std::future<TTSResult> TTSEngine::SynthesizeAsync(const TTSRequest& request) {
         return future;
     }
 
-    // Submit to thread pool
-    pImpl->thread_pool->enqueue([this, request, promise]() {
-        try {
-            pImpl->total_requests++;
-            auto result = pImpl->ProcessSynthesis(request);
-            promise->set_value(result);
-        } catch (...) {
-            TTSResult error_result;
-            error_result.status = Status::ERROR_UNKNOWN;
-            error_result.error_message = "Unknown error in async synthesis";
-            promise->set_value(error_result);
-        }
+    // Route through the scheduler so request priority is honoured
+    pImpl->ScheduleRequest(request, [promise](TTSResult result) {
+        promise->set_value(std::move(result));
     });
 
     return future;
 }
 
+std::string TTSEngine::SubmitRequest(const TTSRequest& request, AudioCallback callback) {
+    if (!pImpl->initialized) {
+        return "";
+    }
+
+    auto error_callback = pImpl->error_callback;
+    return pImpl->ScheduleRequest(request, [callback, error_callback](TTSResult result) {
+        if (result.IsSuccess()) {
+            if (callback) {
+                callback(result.audio);
+            }
+        } else if (error_callback) {
+            error_callback(result.status, result.error_message);
+        }
+    });
+}
+
+bool TTSEngine::IsRequestComplete(const std::string& request_id) const {
+    // Unknown IDs have either finished long ago or never existed
+    return !pImpl->scheduler || !pImpl->scheduler->IsPending(request_id);
+}
+
+bool TTSEngine::CancelRequest(const std::string& request_id) {
+    return pImpl->CancelScheduled(request_id);
+}
+
+std::vector<PhonemeInfo> TTSEngine::TextToPhonemes(const std::string& text) {
+    auto snap = pImpl->CurrentSnapshot();
+    if (!snap->phonemizer) {
+        return {};
+    }
+    ResultDiagnostics diagnostics;
+    diagnostics.SetPhonemes(snap->phonemizer->Phonemize(snap->phonemizer->NormalizeText(text)));
+    return diagnostics.ExpandPhonemes();
+}
+
+std::vector<int> TTSEngine::PhonemesToTokens(const std::string& phonemes) {
+    auto snap = pImpl->CurrentSnapshot();
+    if (!snap->tokenizer) {
+        return {};
+    }
+    return snap->tokenizer->PhonemesToTokens(phonemes);
+}
+
+std::vector<TokenInfo> TTSEngine::DescribeTokens(const std::vector<int>& tokens) const {
+    auto snap = pImpl->CurrentSnapshot();
+    std::vector<TokenInfo> described;
+    if (!snap->tokenizer) {
+        return described;
+    }
+
+    described.reserve(tokens.size());
+    for (size_t i = 0; i < tokens.size(); i++) {
+        described.push_back(TokenInfo{tokens[i], snap->tokenizer->GetPhoneme(tokens[i]),
+                                      static_cast<int>(i)});
+    }
+    return described;
+}
+
+size_t TTSEngine::GetVocabularySize() const {
+    auto snap = pImpl->CurrentSnapshot();
+    return snap->tokenizer ? snap->tokenizer->GetVocabularySize() : 0;
+}
+
+std::pair<std::string, std::vector<int>> TTSEngine::ProcessText(const std::string& text) {
+    // One snapshot for both steps so phonemes and tokens always match
+    auto snap = pImpl->CurrentSnapshot();
+    if (!snap->phonemizer || !snap->tokenizer) {
+        return {};
+    }
+    std::string phonemes = snap->phonemizer->Phonemize(snap->phonemizer->NormalizeText(text));
+    std::vector<int> tokens = snap->tokenizer->PhonemesToTokens(phonemes);
+    return {std::move(phonemes), std::move(tokens)};
+}
+
+std::string TTSEngine::NormalizeText(const std::string& text) {
+    auto snap = pImpl->CurrentSnapshot();
+    return snap->phonemizer ? snap->phonemizer->NormalizeText(text) : text;
+}
+
 Status TTSEngine::LoadVoice(const std::string& voice_path) {
-    return pImpl->voice_manager->LoadVoice(voice_path);
+    // Held so a concurrent reload cannot publish a voice set without this voice
+    Status status;
+    {
+        std::lock_guard<std::mutex> lock(pImpl->reload_mutex);
+        status = pImpl->CurrentSnapshot()->voice_manager->LoadVoice(voice_path);
+        if (status == Status::OK) {
+            pImpl->extra_voice_paths.push_back(voice_path);
+        }
+    }
+    pImpl->EnforceMemoryBudget();
+    return status;
 }
 
 std::vector<Voice> TTSEngine::GetAvailableVoices() const {
-    return pImpl->voice_manager->GetAllVoices();
+    return pImpl->CurrentSnapshot()->voice_manager->GetAllVoices();
 }
 
 void TTSEngine::ClearCache() {
     pImpl->cache_manager->Clear();
 }
 
+TTSEngine::CacheStats TTSEngine::GetCacheStats() const {
+    auto cache = pImpl->cache_manager->GetStats();
+
+    CacheStats stats;
+    stats.total_entries = cache.total_entries;
+    stats.total_size_bytes = cache.total_size_bytes;
+    stats.hit_count = cache.hit_count;
+    stats.miss_count = cache.miss_count;
+    stats.hit_rate = cache.hit_rate;
+    stats.inflight_leader_count = pImpl->in_flight.GetLeaderCount();
+    stats.inflight_attach_count = pImpl->in_flight.GetAttachCount();
+    return stats;
+}
+
 Status TTSEngine::SaveAudioToFile(const AudioData& audio, const std::string& filepath, AudioFormat format) {
     return pImpl->audio_processor->SaveToFile(audio, filepath, format);
 }
 
 size_t TTSEngine::GetQueueSize() const {
-    std::lock_guard<std::mutex> lock(pImpl->queue_mutex);
-    return pImpl->request_queue.size();
+    return pImpl->scheduler ? pImpl->scheduler->GetQueueSize() : 0;
 }
 
 size_t TTSEngine::GetActiveSynthesisCount() const {
     return pImpl->active_synthesis_count;
 }
 
+namespace {
+
+TTSEngine::LatencyPercentiles ToPercentiles(const LatencyHistogram::Snapshot& snapshot) {
+    TTSEngine::LatencyPercentiles result;
+    result.count = snapshot.count;
+    result.p50 = std::chrono::microseconds(snapshot.Percentile(50.0));
+    result.p90 = std::chrono::microseconds(snapshot.Percentile(90.0));
+    result.p99 = std::chrono::microseconds(snapshot.Percentile(99.0));
+    result.p999 = std::chrono::microseconds(snapshot.Percentile(99.9));
+    return result;
+}
+
+} // namespace
+
+TTSEngine::PerformanceStats TTSEngine::GetPerformanceStats() const {
+    PerformanceStats stats;
+    stats.total_requests = pImpl->total_requests;
+    stats.successful_requests = pImpl->successful_requests;
+    stats.failed_requests = pImpl->failed_requests;
+
+    auto total = pImpl->latency.total.GetSnapshot();
+    stats.average_latency = std::chrono::milliseconds(static_cast<int64_t>(total.Mean() / 1000.0));
+    stats.min_latency = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::microseconds(total.min_us));
+    stats.max_latency = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::microseconds(total.max_us));
+
+    auto since = std::chrono::steady_clock::now().time_since_epoch() -
+                 std::chrono::steady_clock::duration(pImpl->stats_start.load());
+    double seconds = std::chrono::duration<double>(since).count();
+    stats.requests_per_second = seconds > 0.0 ?
+        static_cast<float>(stats.successful_requests / seconds) : 0.0f;
+
+    stats.end_to_end = ToPercentiles(total);
+    stats.phonemization = ToPercentiles(pImpl->latency.phonemization.GetSnapshot());
+    stats.tokenization = ToPercentiles(pImpl->latency.tokenization.GetSnapshot());
+    stats.inference = ToPercentiles(pImpl->latency.inference.GetSnapshot());
+    stats.audio_processing = ToPercentiles(pImpl->latency.audio_processing.GetSnapshot());
+    return stats;
+}
+
+void TTSEngine::ResetPerformanceStats() {
+    pImpl->total_requests = 0;
+    pImpl->successful_requests = 0;
+    pImpl->failed_requests = 0;
+
+    pImpl->latency.total.Reset();
+    pImpl->latency.phonemization.Reset();
+    pImpl->latency.tokenization.Reset();
+    pImpl->latency.inference.Reset();
+    pImpl->latency.audio_processing.Reset();
+
+    pImpl->stats_start = std::chrono::steady_clock::now().time_since_epoch().count();
+}
+
+TTSEngine::MemoryUsage TTSEngine::GetMemoryBreakdown() const {
+    return pImpl->MeasureMemory();
+}
+
+size_t TTSEngine::GetMemoryUsage() const {
+    return pImpl->MeasureMemory().total_bytes;
+}
+
+void TTSEngine::ReleaseUnusedResources() {
+    pImpl->cache_manager->CleanExpired();
+
+    auto snap = pImpl->CurrentSnapshot();
+    snap->voice_manager->ReleaseIdleVoices(Impl::kVoiceIdleTime);
+    for (const auto& tier : snap->tiers) {
+        tier.session_manager->ShrinkArena();
+    }
+}
+
+void TTSEngine::SetMaxMemoryUsage(size_t max_bytes) {
+    pImpl->max_memory_bytes = max_bytes;
+    pImpl->EnforceMemoryBudget();
+}
+
+Status TTSEngine::Warmup() {
+    if (!pImpl->initialized) {
+        return Status::ERROR_NOT_INITIALIZED;
+    }
+    return pImpl->RunWarmup(pImpl->CurrentSnapshot());
+}
+
+std::vector<TTSEngine::WarmupStats> TTSEngine::GetWarmupReport() const {
+    std::lock_guard<std::mutex> lock(pImpl->warmup_mutex);
+    return pImpl->warmup_report;
+}
+
+TTSEngine::StartupStats TTSEngine::GetStartupReport() const {
+    std::lock_guard<std::mutex> lock(pImpl->warmup_mutex);
+    return pImpl->startup_report;
+}
+
+Status TTSEngine::DumpTrace(const std::string& path) const {
+    return trace::WriteChromeTrace(path) ? Status::OK : Status::ERROR_FILE_NOT_FOUND;
+}
+
+std::vector<TTSEngine::StageStats> TTSEngine::GetPipelineStats() const {
+    std::vector<StageStats> stats;
+    for (const auto& stage : pImpl->pipeline_stages) {
+        StageStats entry;
+        entry.name = stage->name;
+        entry.workers = stage->workers.size();
+        entry.queue_depth = stage->queue->Size();
+        entry.peak_queue_depth = stage->queue->PeakSize();
+        entry.queue_capacity = stage->queue->Capacity();
+        entry.processed = stage->processed;
+        entry.busy_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::microseconds(stage->busy_us.load()));
+        stats.push_back(entry);
+    }
+    return stats;
+}
+
 // ==========================================
 // Factory Functions
 // ==========================================
@@ -11,6 +11,7 @@
 #include "jp_edge_tts/utils/file_utils.h"
 #include <nlohmann/json.hpp>
 #include <algorithm>
+#include <chrono>
 #include <fstream>
 #include <iostream>
 #include <mutex>
@@ -30,6 +31,11 @@ public:
     std::string default_voice_id;
     mutable std::mutex mutex;
 
+    // Idle tracking; released voices are re-read from their file on demand
+    std::unordered_map<std::string, std::string> voice_paths;
+    std::unordered_map<std::string, std::chrono::steady_clock::time_point> last_used;
+    std::unordered_map<std::string, std::string> released;
+
     Status LoadVoice(const std::string& voice_path) {
         try {
             // Read JSON file
@@ -50,7 +56,12 @@ public:
                 voice_id = FileUtils::GetStem(voice_path);
             }
 
-            return LoadVoiceFromJSON(voice_id, json_str);
+            Status status = LoadVoiceFromJSON(voice_id, json_str);
+            if (status == Status::OK) {
+                std::lock_guard<std::mutex> lock(mutex);
+                voice_paths[voice_id] = voice_path;
+            }
+            return status;
 
         } catch (const json::exception& e) {
             std::cerr << "JSON parse error: " << e.what() << std::endl;
@@ -128,6 +139,8 @@ public:
             {
                 std::lock_guard<std::mutex> lock(mutex);
                 voices[voice_id] = voice;
+                last_used[voice_id] = std::chrono::steady_clock::now();
+                released.erase(voice_id);
 
                 // Set as default if first voice
                 if (voices.size() == 1 || default_voice_id.empty()) {
@@ -143,6 +156,21 @@ public:
         }
     }
 
+    static size_t VoiceBytes(const Voice& voice) {
+        size_t total = sizeof(Voice);
+        total += voice.id.capacity();
+        total += voice.name.capacity();
+        total += voice.language.capacity();
+        total += voice.style_vector.capacity() * sizeof(float);
+        if (voice.description) {
+            total += voice.description->capacity();
+        }
+        if (voice.preview_url) {
+            total += voice.preview_url->capacity();
+        }
+        return total;
+    }
+
     std::vector<float> DecodeBase64FloatVector(const std::string& encoded) {
         // Simple base64 decoding for float vector
         // TODO: Implement proper base64 decoding
@@ -172,7 +200,13 @@ Status VoiceManager::LoadVoice(const std::string& voice_path) {
 }
 
 Status VoiceManager::LoadVoiceFromJSON(const std::string& voice_id, const std::string& json_data) {
-    return pImpl->LoadVoiceFromJSON(voice_id, json_data);
+    Status status = pImpl->LoadVoiceFromJSON(voice_id, json_data);
+    if (status == Status::OK) {
+        // No longer backed by a file, so it must stay resident
+        std::lock_guard<std::mutex> lock(pImpl->mutex);
+        pImpl->voice_paths.erase(voice_id);
+    }
+    return status;
 }
 
 int VoiceManager::LoadVoicesFromDirectory(const std::string& directory) {
@@ -193,13 +227,34 @@ int VoiceManager::LoadVoicesFromDirectory(const std::string& directory) {
 }
 
 std::optional<Voice> VoiceManager::GetVoice(const std::string& voice_id) const {
-    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    std::string released_path;
+
+    {
+        std::lock_guard<std::mutex> lock(pImpl->mutex);
+
+        auto it = pImpl->voices.find(voice_id);
+        if (it != pImpl->voices.end()) {
+            pImpl->last_used[voice_id] = std::chrono::steady_clock::now();
+            return it->second;
+        }
 
+        auto released = pImpl->released.find(voice_id);
+        if (released == pImpl->released.end()) {
+            return std::nullopt;
+        }
+        released_path = released->second;
+    }
+
+    // Released under memory pressure; bring it back
+    if (pImpl->LoadVoice(released_path) != Status::OK) {
+        return std::nullopt;
+    }
+
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
     auto it = pImpl->voices.find(voice_id);
     if (it != pImpl->voices.end()) {
         return it->second;
     }
-
     return std::nullopt;
 }
 
@@ -221,13 +276,17 @@ std::vector<std::string> VoiceManager::GetVoiceIds() const {
     for (const auto& [id, voice] : pImpl->voices) {
         result.push_back(id);
     }
+    for (const auto& [id, path] : pImpl->released) {
+        result.push_back(id);
+    }
 
     return result;
 }
 
 bool VoiceManager::HasVoice(const std::string& voice_id) const {
     std::lock_guard<std::mutex> lock(pImpl->mutex);
-    return pImpl->voices.find(voice_id) != pImpl->voices.end();
+    return pImpl->voices.find(voice_id) != pImpl->voices.end() ||
+           pImpl->released.find(voice_id) != pImpl->released.end();
 }
 
 bool VoiceManager::SetDefaultVoice(const std::string& voice_id) {
@@ -249,6 +308,10 @@ std::string VoiceManager::GetDefaultVoiceId() const {
 bool VoiceManager::UnloadVoice(const std::string& voice_id) {
     std::lock_guard<std::mutex> lock(pImpl->mutex);
 
+    pImpl->voice_paths.erase(voice_id);
+    pImpl->last_used.erase(voice_id);
+    bool was_released = pImpl->released.erase(voice_id) > 0;
+
     auto it = pImpl->voices.find(voice_id);
     if (it != pImpl->voices.end()) {
         pImpl->voices.erase(it);
@@ -265,12 +328,15 @@ bool VoiceManager::UnloadVoice(const std::string& voice_id) {
         return true;
     }
 
-    return false;
+    return was_released;
 }
 
 void VoiceManager::ClearVoices() {
     std::lock_guard<std::mutex> lock(pImpl->mutex);
     pImpl->voices.clear();
+    pImpl->voice_paths.clear();
+    pImpl->last_used.clear();
+    pImpl->released.clear();
     pImpl->default_voice_id.clear();
 }
 
@@ -284,22 +350,37 @@ size_t VoiceManager::GetMemoryUsage() const {
 
     size_t total = 0;
     for (const auto& [id, voice] : pImpl->voices) {
-        total += sizeof(Voice);
-        total += voice.id.capacity();
-        total += voice.name.capacity();
-        total += voice.language.capacity();
-        total += voice.style_vector.capacity() * sizeof(float);
-        if (voice.description) {
-            total += voice.description->capacity();
-        }
-        if (voice.preview_url) {
-            total += voice.preview_url->capacity();
-        }
+        total += Impl::VoiceBytes(voice);
     }
 
     return total;
 }
 
+size_t VoiceManager::ReleaseIdleVoices(std::chrono::seconds idle_for) {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+
+    auto cutoff = std::chrono::steady_clock::now() - idle_for;
+    size_t freed = 0;
+
+    for (auto it = pImpl->voices.begin(); it != pImpl->voices.end();) {
+        const std::string& id = it->first;
+        auto path = pImpl->voice_paths.find(id);
+
+        // Only file-backed voices can be brought back; the default stays
+        if (id == pImpl->default_voice_id || path == pImpl->voice_paths.end() ||
+            pImpl->last_used[id] > cutoff) {
+            ++it;
+            continue;
+        }
+
+        freed += Impl::VoiceBytes(it->second);
+        pImpl->released[id] = path->second;
+        it = pImpl->voices.erase(it);
+    }
+
+    return freed;
+}
+
 bool VoiceManager::ExportVoice(const std::string& voice_id, const std::string& output_path) const {
     std::lock_guard<std::mutex> lock(pImpl->mutex);
 
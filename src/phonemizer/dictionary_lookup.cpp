@@ -146,6 +146,16 @@ size_t DictionaryLookup::Size() const {
     return pImpl->GetSize();
 }
 
+size_t DictionaryLookup::GetMemoryUsage() const {
+    // Node and bucket overhead dominate for short words
+    size_t total = pImpl->dictionary.bucket_count() * sizeof(void*);
+    for (const auto& [word, phonemes] : pImpl->dictionary) {
+        total += sizeof(std::pair<const std::string, std::string>) + sizeof(void*);
+        total += word.capacity() + phonemes.capacity();
+    }
+    return total;
+}
+
 void DictionaryLookup::Clear() {
     pImpl->ClearAll();
 }
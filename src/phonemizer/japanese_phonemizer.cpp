@@ -9,6 +9,7 @@
 
 #include "jp_edge_tts/phonemizer/japanese_phonemizer.h"
 #include "jp_edge_tts/utils/string_utils.h"
+#include "jp_edge_tts/utils/trace.h"
 #include <algorithm>
 #include <sstream>
 #include <iostream>
@@ -40,6 +41,7 @@ public:
         
         // First, try dictionary lookup with reading and POS
         if (use_dictionary) {
+            JP_TRACE_SCOPE("dictionary_lookup");
             auto result = dictionary.LookupWithReading(
                 morpheme.surface,
                 morpheme.reading,
@@ -347,6 +349,10 @@ void JapanesePhonemizer::ResetStats() {
     pImpl->total_words = 0;
 }
 
+size_t JapanesePhonemizer::GetMemoryUsage() const {
+    return pImpl->dictionary.GetMemoryUsage();
+}
+
 MeCabWrapper& JapanesePhonemizer::GetMeCab() {
     return pImpl->mecab;
 }
@@ -29,6 +29,11 @@ public:
     // Special tokens
     IPATokenizer::SpecialTokens special_tokens;
 
+    // Prosodic boundary token IDs used for chunking
+    std::unordered_set<int> sentence_boundary_ids;
+    std::unordered_set<int> clause_boundary_ids;
+    std::unordered_set<int> space_ids;
+
     Impl() : is_loaded(false) {
         // Set default special token IDs
         special_tokens.pad_token = 0;
@@ -98,9 +103,28 @@ public:
             pos = value_end;
         }
 
+        UpdateBoundaryIds();
+
         is_loaded = !phoneme_to_id.empty();
         return is_loaded;
     }
+
+    void UpdateBoundaryIds() {
+        auto collect = [this](std::initializer_list<const char*> symbols,
+                              std::unordered_set<int>& ids) {
+            ids.clear();
+            for (const char* symbol : symbols) {
+                auto it = phoneme_to_id.find(symbol);
+                if (it != phoneme_to_id.end()) {
+                    ids.insert(it->second);
+                }
+            }
+        };
+
+        collect({".", "!", "?", "\xE2\x80\xA6"}, sentence_boundary_ids);     // … (U+2026)
+        collect({",", ";", ":", "\xE2\x80\x94"}, clause_boundary_ids);       // — (U+2014)
+        collect({" "}, space_ids);
+    }
 };
 
 // ==========================================
@@ -277,4 +301,59 @@ std::vector<int> IPATokenizer::TruncateTokens(const std::vector<int>& tokens,
     return std::vector<int>(tokens.begin(), tokens.begin() + max_length);
 }
 
+std::vector<std::vector<int>> IPATokenizer::ChunkTokens(const std::vector<int>& tokens,
+                                                      size_t max_tokens) const {
+    std::vector<std::vector<int>> chunks;
+
+    if (max_tokens == 0 || tokens.size() <= max_tokens) {
+        if (!tokens.empty()) {
+            chunks.push_back(tokens);
+        }
+        return chunks;
+    }
+
+    size_t start = 0;
+    while (start < tokens.size()) {
+        size_t remaining = tokens.size() - start;
+        if (remaining <= max_tokens) {
+            chunks.emplace_back(tokens.begin() + start, tokens.end());
+            break;
+        }
+
+        // Find the last boundary of each strength within the budget.
+        // Cut positions are one past the boundary token.
+        size_t window_end = start + max_tokens;
+        size_t last_sentence = 0;
+        size_t last_clause = 0;
+        size_t last_space = 0;
+
+        for (size_t i = start; i < window_end; ++i) {
+            int id = tokens[i];
+            if (pImpl->sentence_boundary_ids.count(id)) {
+                last_sentence = i + 1;
+            } else if (pImpl->clause_boundary_ids.count(id)) {
+                last_clause = i + 1;
+            } else if (pImpl->space_ids.count(id)) {
+                last_space = i + 1;
+            }
+        }
+
+        // Prefer a sentence end unless it would leave a very short chunk
+        size_t min_cut = start + max_tokens / 2;
+        size_t cut = window_end;
+        if (last_sentence > min_cut) {
+            cut = last_sentence;
+        } else if (std::max(last_sentence, last_clause) > start) {
+            cut = std::max(last_sentence, last_clause);
+        } else if (last_space > start) {
+            cut = last_space;
+        }
+
+        chunks.emplace_back(tokens.begin() + start, tokens.begin() + cut);
+        start = cut;
+    }
+
+    return chunks;
+}
+
 } // namespace jp_edge_tts
\ No newline at end of file
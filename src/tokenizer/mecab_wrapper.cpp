@@ -8,6 +8,7 @@
  */
 
 #include "jp_edge_tts/tokenizer/mecab_wrapper.h"
+#include "jp_edge_tts/utils/trace.h"
 
 #ifdef USE_MECAB
 #include <mecab.h>
@@ -101,6 +102,7 @@ public:
     }
 
     std::vector<MorphemeInfo> Parse(const std::string& text) {
+        JP_TRACE_SCOPE("mecab_parse");
         std::vector<MorphemeInfo> result;
 
 #ifdef USE_MECAB
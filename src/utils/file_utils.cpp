@@ -110,6 +110,12 @@ int64_t FileUtils::GetFileSize(const std::string& path) {
     return ec ? -1 : static_cast<int64_t>(size);
 }
 
+int64_t FileUtils::GetModificationTime(const std::string& path) {
+    std::error_code ec;
+    auto time = fs::last_write_time(path, ec);
+    return ec ? -1 : static_cast<int64_t>(time.time_since_epoch().count());
+}
+
 std::string FileUtils::GetExtension(const std::string& path) {
     return fs::path(path).extension().string();
 }
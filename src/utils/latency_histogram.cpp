@@ -0,0 +1,166 @@
+/**
+ * @file latency_histogram.cpp
+ * @brief Implementation of the log-bucketed latency histogram
+ * @author D Everett Hinton
+ * @date 2025
+ *
+ * @copyright MIT License
+ */
+
+#include "jp_edge_tts/utils/latency_histogram.h"
+#include <algorithm>
+#include <cmath>
+
+namespace jp_edge_tts {
+
+namespace {
+
+// Highest set bit; value must be non-zero
+int HighestBit(uint64_t value) {
+    int bit = 0;
+    while (value >>= 1) {
+        ++bit;
+    }
+    return bit;
+}
+
+// Shard assigned to the calling thread, round-robin on first use
+size_t ThreadShardIndex() {
+    static std::atomic<size_t> next_shard{0};
+    thread_local size_t index = next_shard.fetch_add(1, std::memory_order_relaxed);
+    return index;
+}
+
+} // namespace
+
+// ==========================================
+// Bucket Layout
+// ==========================================
+
+size_t LatencyHistogram::BucketIndex(uint64_t value_us) {
+    if (value_us < SUB_BUCKET_COUNT) {
+        return static_cast<size_t>(value_us);
+    }
+
+    int exponent = std::min(HighestBit(value_us), MAX_EXPONENT);
+    if (exponent == MAX_EXPONENT) {
+        return BUCKET_COUNT - 1;
+    }
+
+    uint64_t sub_bucket = (value_us >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKET_COUNT - 1);
+    return static_cast<size_t>((exponent - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT + sub_bucket);
+}
+
+uint64_t LatencyHistogram::BucketLowerBound(size_t index) {
+    if (index < SUB_BUCKET_COUNT) {
+        return index;
+    }
+
+    int exponent = static_cast<int>(index / SUB_BUCKET_COUNT) + SUB_BUCKET_BITS - 1;
+    uint64_t sub_bucket = index % SUB_BUCKET_COUNT;
+    return (SUB_BUCKET_COUNT + sub_bucket) << (exponent - SUB_BUCKET_BITS);
+}
+
+uint64_t LatencyHistogram::BucketUpperBound(size_t index) {
+    if (index < SUB_BUCKET_COUNT) {
+        return index;
+    }
+
+    int exponent = static_cast<int>(index / SUB_BUCKET_COUNT) + SUB_BUCKET_BITS - 1;
+    return BucketLowerBound(index) + (uint64_t{1} << (exponent - SUB_BUCKET_BITS)) - 1;
+}
+
+// ==========================================
+// Recording
+// ==========================================
+
+LatencyHistogram::LatencyHistogram() : shards(SHARD_COUNT) {
+    Reset();
+}
+
+LatencyHistogram::Shard& LatencyHistogram::LocalShard() {
+    return shards[ThreadShardIndex() % shards.size()];
+}
+
+void LatencyHistogram::Record(std::chrono::microseconds latency) {
+    RecordMicros(static_cast<uint64_t>(std::max<int64_t>(0, latency.count())));
+}
+
+void LatencyHistogram::RecordMicros(uint64_t latency_us) {
+    Shard& shard = LocalShard();
+    shard.buckets[BucketIndex(latency_us)].fetch_add(1, std::memory_order_relaxed);
+    shard.count.fetch_add(1, std::memory_order_relaxed);
+    shard.sum_us.fetch_add(latency_us, std::memory_order_relaxed);
+
+    uint64_t current = shard.min_us.load(std::memory_order_relaxed);
+    while (latency_us < current &&
+           !shard.min_us.compare_exchange_weak(current, latency_us, std::memory_order_relaxed)) {
+    }
+    current = shard.max_us.load(std::memory_order_relaxed);
+    while (latency_us > current &&
+           !shard.max_us.compare_exchange_weak(current, latency_us, std::memory_order_relaxed)) {
+    }
+}
+
+void LatencyHistogram::Reset() {
+    for (auto& shard : shards) {
+        for (auto& bucket : shard.buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        shard.count.store(0, std::memory_order_relaxed);
+        shard.sum_us.store(0, std::memory_order_relaxed);
+        shard.min_us.store(UINT64_MAX, std::memory_order_relaxed);
+        shard.max_us.store(0, std::memory_order_relaxed);
+    }
+}
+
+// ==========================================
+// Reading
+// ==========================================
+
+LatencyHistogram::Snapshot LatencyHistogram::GetSnapshot() const {
+    Snapshot snapshot;
+    snapshot.buckets.assign(BUCKET_COUNT, 0);
+
+    uint64_t min_us = UINT64_MAX;
+    for (const auto& shard : shards) {
+        for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+            snapshot.buckets[i] += shard.buckets[i].load(std::memory_order_relaxed);
+        }
+        snapshot.count += shard.count.load(std::memory_order_relaxed);
+        snapshot.sum_us += shard.sum_us.load(std::memory_order_relaxed);
+        min_us = std::min(min_us, shard.min_us.load(std::memory_order_relaxed));
+        snapshot.max_us = std::max(snapshot.max_us, shard.max_us.load(std::memory_order_relaxed));
+    }
+    snapshot.min_us = snapshot.count > 0 ? min_us : 0;
+
+    return snapshot;
+}
+
+uint64_t LatencyHistogram::Snapshot::Percentile(double percentile) const {
+    if (count == 0 || buckets.empty()) {
+        return 0;
+    }
+
+    percentile = std::clamp(percentile, 0.0, 100.0);
+    uint64_t rank = static_cast<uint64_t>(std::ceil(percentile / 100.0 * count));
+    rank = std::max<uint64_t>(rank, 1);
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            // Midpoint of the bucket, kept inside the observed range
+            uint64_t lower = BucketLowerBound(i);
+            uint64_t value = lower + (BucketUpperBound(i) - lower) / 2;
+            return std::clamp(value, min_us, max_us);
+        }
+    }
+    return max_us;
+}
+
+double LatencyHistogram::Snapshot::Mean() const {
+    return count > 0 ? static_cast<double>(sum_us) / count : 0.0;
+}
+
+} // namespace jp_edge_tts
@@ -0,0 +1,147 @@
+/**
+ * @file mapped_file.cpp
+ * @brief Implementation of read-only memory-mapped files
+ * @author JP Edge TTS Project
+ * @date 2024
+ *
+ * @copyright MIT License
+ */
+
+#include "jp_edge_tts/utils/mapped_file.h"
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace jp_edge_tts {
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        Close();
+        std::swap(address, other.address);
+        std::swap(length, other.length);
+        std::swap(file_path, other.file_path);
+#ifdef _WIN32
+        std::swap(mapping_handle, other.mapping_handle);
+#endif
+    }
+    return *this;
+}
+
+#ifdef _WIN32
+
+bool MappedFile::Open(const std::string& path, const Options& options) {
+    Close();
+
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+
+    // The mapping keeps the file open; the file handle is no longer needed
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapping) {
+        return false;
+    }
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        return false;
+    }
+
+    // Windows has no per-range readahead or huge-page hint for file views
+    (void)options;
+
+    address = view;
+    length = static_cast<size_t>(file_size.QuadPart);
+    file_path = path;
+    mapping_handle = mapping;
+    return true;
+}
+
+void MappedFile::Close() {
+    if (address) {
+        UnmapViewOfFile(address);
+        CloseHandle(static_cast<HANDLE>(mapping_handle));
+    }
+    address = nullptr;
+    mapping_handle = nullptr;
+    length = 0;
+    file_path.clear();
+}
+
+#else
+
+bool MappedFile::Open(const std::string& path, const Options& options) {
+    Close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+
+    size_t file_size = static_cast<size_t>(info.st_size);
+    void* mapped = mmap(nullptr, file_size, PROT_READ, MAP_SHARED, fd, 0);
+    // The mapping holds its own reference to the file
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        return false;
+    }
+
+    // Hints are advisory; kernels without support simply return an error
+#ifdef MADV_HUGEPAGE
+    if (options.huge_pages) {
+        madvise(mapped, file_size, MADV_HUGEPAGE);
+    }
+#endif
+    if (options.prefetch) {
+        madvise(mapped, file_size, MADV_WILLNEED);
+    }
+
+    address = mapped;
+    length = file_size;
+    file_path = path;
+    return true;
+}
+
+void MappedFile::Close() {
+    if (address) {
+        munmap(address, length);
+    }
+    address = nullptr;
+    length = 0;
+    file_path.clear();
+}
+
+#endif
+
+} // namespace jp_edge_tts
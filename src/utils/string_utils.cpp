@@ -72,6 +72,81 @@ std::string StringUtils::Trim(const std::string& str) {
     return str.substr(start, end - start + 1);
 }
 
+std::vector<std::string> StringUtils::SplitSentences(const std::string& text,
+                                                  size_t min_clause_length) {
+    static const std::vector<std::string> sentence_ends = {
+        "\xE3\x80\x82",  // 。
+        "\xEF\xBC\x81",  // ！
+        "\xEF\xBC\x9F",  // ？
+        "\xEF\xBC\x8E",  // ．
+        "\xE2\x80\xA6",  // …
+        "!", "?", "\n"
+    };
+    static const std::vector<std::string> clause_ends = {
+        "\xE3\x80\x81",  // 、
+        "\xEF\xBC\x8C",  // ，
+        "\xEF\xBC\x9B",  // ；
+        "\xEF\xBC\x9A",  // ：
+        ",", ";", ":"
+    };
+
+    auto match_at = [&text](size_t pos, const std::vector<std::string>& marks) -> size_t {
+        for (const auto& mark : marks) {
+            if (text.compare(pos, mark.size(), mark) == 0) {
+                return mark.size();
+            }
+        }
+        return 0;
+    };
+
+    std::vector<std::string> result;
+    size_t piece_start = 0;
+    size_t piece_chars = 0;
+    size_t pos = 0;
+
+    auto flush = [&](size_t end) {
+        std::string piece = Trim(text.substr(piece_start, end - piece_start));
+        if (!piece.empty()) {
+            result.push_back(std::move(piece));
+        }
+        piece_start = end;
+        piece_chars = 0;
+    };
+
+    while (pos < text.size()) {
+        size_t len = match_at(pos, sentence_ends);
+        if (len > 0) {
+            pos += len;
+            // Keep runs of terminators such as "！？" or "……" together
+            while (pos < text.size() && (len = match_at(pos, sentence_ends)) > 0) {
+                pos += len;
+            }
+            flush(pos);
+            continue;
+        }
+
+        len = match_at(pos, clause_ends);
+        if (len > 0) {
+            pos += len;
+            if (piece_chars + 1 >= min_clause_length) {
+                flush(pos);
+            } else {
+                piece_chars++;
+            }
+            continue;
+        }
+
+        // Advance one UTF-8 code point
+        unsigned char lead = static_cast<unsigned char>(text[pos]);
+        size_t step = (lead < 0x80) ? 1 : (lead >> 5) == 0x6 ? 2 : (lead >> 4) == 0xE ? 3 : 4;
+        pos = std::min(pos + step, text.size());
+        piece_chars++;
+    }
+
+    flush(text.size());
+    return result;
+}
+
 std::string StringUtils::ToLower(const std::string& str) {
     std::string result = str;
     std::transform(result.begin(), result.end(), result.begin(),
@@ -0,0 +1,151 @@
+/**
+ * @file token_file.cpp
+ * @brief Implementation of the binary token file format
+ * @author JP Edge TTS Project
+ * @date 2024
+ *
+ * @copyright MIT License
+ */
+
+#include "jp_edge_tts/utils/token_file.h"
+#include "jp_edge_tts/utils/file_utils.h"
+#include <algorithm>
+#include <cstring>
+
+namespace jp_edge_tts {
+
+namespace {
+
+const char kMagic[4] = {'J', 'P', 'T', 'K'};
+
+void PutUint(std::vector<uint8_t>& out, uint32_t value, size_t bytes) {
+    for (size_t i = 0; i < bytes; i++) {
+        out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+/**
+ * @brief Bounds-checked little-endian reader over a byte buffer
+ */
+class Reader {
+public:
+    explicit Reader(const std::vector<uint8_t>& data) : data(data) {}
+
+    bool GetUint(uint32_t& value, size_t bytes) {
+        if (data.size() - offset < bytes) {
+            return false;
+        }
+        value = 0;
+        for (size_t i = 0; i < bytes; i++) {
+            value |= static_cast<uint32_t>(data[offset + i]) << (8 * i);
+        }
+        offset += bytes;
+        return true;
+    }
+
+    bool GetBytes(char* out, size_t count) {
+        if (data.size() - offset < count) {
+            return false;
+        }
+        std::memcpy(out, data.data() + offset, count);
+        offset += count;
+        return true;
+    }
+
+    size_t Remaining() const { return data.size() - offset; }
+
+private:
+    const std::vector<uint8_t>& data;
+    size_t offset = 0;
+};
+
+} // namespace
+
+bool TokenFile::Write(const std::string& path,
+                      const std::vector<TokenRecord>& records,
+                      uint32_t vocabulary_size) {
+    int max_token = 0;
+    for (const auto& record : records) {
+        for (int token : record.tokens) {
+            if (token < 0 || token > 0xFFFF) {
+                return false;
+            }
+            max_token = std::max(max_token, token);
+        }
+        if (record.id.size() > 0xFFFF) {
+            return false;
+        }
+    }
+    size_t width = max_token <= 0xFF ? 1 : 2;
+
+    std::vector<uint8_t> out(kMagic, kMagic + sizeof(kMagic));
+    PutUint(out, FORMAT_VERSION, 2);
+    PutUint(out, static_cast<uint32_t>(width), 2);
+    PutUint(out, vocabulary_size, 4);
+    PutUint(out, static_cast<uint32_t>(records.size()), 4);
+
+    for (const auto& record : records) {
+        PutUint(out, static_cast<uint32_t>(record.id.size()), 2);
+        out.insert(out.end(), record.id.begin(), record.id.end());
+        PutUint(out, static_cast<uint32_t>(record.tokens.size()), 4);
+        for (int token : record.tokens) {
+            PutUint(out, static_cast<uint32_t>(token), width);
+        }
+    }
+
+    return FileUtils::WriteBinaryFile(path, out);
+}
+
+bool TokenFile::Read(const std::string& path,
+                     std::vector<TokenRecord>& records,
+                     uint32_t* vocabulary_size) {
+    std::vector<uint8_t> data = FileUtils::ReadBinaryFile(path);
+    Reader reader(data);
+
+    char magic[sizeof(kMagic)];
+    uint32_t version = 0;
+    uint32_t width = 0;
+    uint32_t vocab = 0;
+    uint32_t count = 0;
+    if (!reader.GetBytes(magic, sizeof(magic)) ||
+        std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 ||
+        !reader.GetUint(version, 2) || version != FORMAT_VERSION ||
+        !reader.GetUint(width, 2) || (width != 1 && width != 2) ||
+        !reader.GetUint(vocab, 4) || !reader.GetUint(count, 4)) {
+        return false;
+    }
+
+    records.clear();
+    records.reserve(std::min<size_t>(count, reader.Remaining()));
+
+    for (uint32_t r = 0; r < count; r++) {
+        TokenRecord record;
+        uint32_t id_length = 0;
+        uint32_t token_count = 0;
+
+        if (!reader.GetUint(id_length, 2)) {
+            return false;
+        }
+        record.id.resize(id_length);
+        if (!reader.GetBytes(&record.id[0], id_length) ||
+            !reader.GetUint(token_count, 4) ||
+            reader.Remaining() < static_cast<size_t>(token_count) * width) {
+            return false;
+        }
+
+        record.tokens.resize(token_count);
+        for (uint32_t t = 0; t < token_count; t++) {
+            uint32_t token = 0;
+            reader.GetUint(token, width);
+            record.tokens[t] = static_cast<int>(token);
+        }
+        records.push_back(std::move(record));
+    }
+
+    if (vocabulary_size) {
+        *vocabulary_size = vocab;
+    }
+    return true;
+}
+
+} // namespace jp_edge_tts
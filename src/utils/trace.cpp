@@ -0,0 +1,202 @@
+/**
+ * @file trace.cpp
+ * @brief Implementation of per-thread span ring buffers
+ * @author D Everett Hinton
+ * @date 2025
+ *
+ * @copyright MIT License
+ */
+
+#include "jp_edge_tts/utils/trace.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace jp_edge_tts {
+namespace trace {
+
+namespace {
+
+constexpr size_t SPANS_PER_THREAD = 16384;
+
+struct Span {
+    const char* name;
+    const char* category;
+    uint64_t start_us;
+    uint64_t duration_us;
+};
+
+/**
+ * @brief Ring buffer written by one thread
+ *
+ * @details The mutex is only contended while a dump or clear is in
+ * progress, so recording stays cheap. The ring grows as spans arrive,
+ * up to SPANS_PER_THREAD, so threads that record little hold little.
+ */
+struct ThreadBuffer {
+    uint32_t thread_index = 0;
+    std::vector<Span> spans;
+    size_t next = 0;
+    bool wrapped = false;
+    bool exited = false;        // Owning thread is gone
+    std::mutex mutex;
+
+    bool Empty() const { return next == 0 && !wrapped; }
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;  // Outlive their threads
+    uint32_t next_thread_index = 1;
+};
+
+Registry& GetRegistry() {
+    static Registry registry;
+    return registry;
+}
+
+/**
+ * @brief Hands the buffer back when its thread exits
+ *
+ * @details Spans of exited threads are kept until they are dumped and
+ * cleared; an empty buffer is released at once and its slot reused by
+ * the next new thread, so short-lived threads do not pile up.
+ */
+struct LocalHandle {
+    std::shared_ptr<ThreadBuffer> buffer;
+
+    LocalHandle() {
+        auto& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        for (auto& existing : registry.buffers) {
+            std::lock_guard<std::mutex> buffer_lock(existing->mutex);
+            if (existing->exited && existing->Empty()) {
+                existing->exited = false;
+                buffer = existing;
+                return;
+            }
+        }
+        buffer = std::make_shared<ThreadBuffer>();
+        buffer->thread_index = registry.next_thread_index++;
+        registry.buffers.push_back(buffer);
+    }
+
+    ~LocalHandle() {
+        std::lock_guard<std::mutex> lock(buffer->mutex);
+        buffer->exited = true;
+        if (buffer->Empty()) {
+            std::vector<Span>().swap(buffer->spans);
+        }
+    }
+};
+
+ThreadBuffer& LocalBuffer() {
+    thread_local LocalHandle handle;
+    return *handle.buffer;
+}
+
+void WriteEscaped(std::ostream& out, const char* text) {
+    for (const char* c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\') {
+            out << '\\';
+        }
+        out << *c;
+    }
+}
+
+} // namespace
+
+uint64_t NowMicros() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void RecordSpan(const char* name, const char* category,
+                uint64_t start_us, uint64_t duration_us) {
+    ThreadBuffer& buffer = LocalBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+
+    Span span{name, category, start_us, duration_us};
+    if (!buffer.wrapped && buffer.spans.size() < SPANS_PER_THREAD) {
+        buffer.spans.push_back(span);
+        buffer.next = buffer.spans.size();
+    } else {
+        buffer.spans[buffer.next++] = span;
+    }
+    if (buffer.next == SPANS_PER_THREAD) {
+        buffer.next = 0;
+        buffer.wrapped = true;
+    }
+}
+
+bool WriteChromeTrace(const std::string& path) {
+    std::ofstream out(path);
+    if (!out) {
+        return false;
+    }
+
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    {
+        auto& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        buffers = registry.buffers;
+    }
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+
+    for (const auto& buffer : buffers) {
+        std::vector<Span> spans;
+        {
+            std::lock_guard<std::mutex> lock(buffer->mutex);
+            if (buffer->wrapped) {
+                spans.assign(buffer->spans.begin() + buffer->next, buffer->spans.end());
+            }
+            spans.insert(spans.end(), buffer->spans.begin(), buffer->spans.begin() + buffer->next);
+        }
+
+        if (spans.empty()) {
+            continue;
+        }
+
+        // Name the track so viewers show one row per thread
+        out << (first ? "" : ",") << "\n{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":"
+            << buffer->thread_index << ",\"args\":{\"name\":\"thread-"
+            << buffer->thread_index << "\"}}";
+        first = false;
+
+        for (const auto& span : spans) {
+            out << ",\n{\"ph\":\"X\",\"name\":\"";
+            WriteEscaped(out, span.name);
+            out << "\",\"cat\":\"";
+            WriteEscaped(out, span.category);
+            out << "\",\"ts\":" << span.start_us
+                << ",\"dur\":" << span.duration_us
+                << ",\"pid\":1,\"tid\":" << buffer->thread_index << "}";
+        }
+    }
+
+    out << "\n]}\n";
+    return static_cast<bool>(out);
+}
+
+void Clear() {
+    auto& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (auto& buffer : registry.buffers) {
+        std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+        buffer->next = 0;
+        buffer->wrapped = false;
+        if (buffer->exited) {
+            std::vector<Span>().swap(buffer->spans);
+        } else {
+            buffer->spans.clear();
+        }
+    }
+}
+
+} // namespace trace
+} // namespace jp_edge_tts
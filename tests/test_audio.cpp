@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "jp_edge_tts/audio/audio_processor.h"
+#include "jp_edge_tts/audio/inverse_stft.h"
 #include "jp_edge_tts/types.h"
 #include <vector>
 #include <cmath>
@@ -242,6 +243,83 @@ TEST_F(AudioTest, PitchAndSpeedModification) {
     EXPECT_GT(speed_down.size(), test_audio.size());  // Should be longer
 }
 
+TEST_F(AudioTest, CrossfadeConcatenation) {
+    // 10ms at 24kHz = 240 overlapping samples per seam
+    std::vector<float> first(1000, 0.5f);
+    std::vector<float> second(1000, 0.5f);
+
+    auto joined = processor->ConcatenateWithCrossfade({first, second}, 10);
+    EXPECT_EQ(joined.size(), first.size() + second.size() - 240);
+
+    // Crossfading equal constant signals must not change the level
+    for (float sample : joined) {
+        EXPECT_NEAR(sample, 0.5f, 1e-5f);
+    }
+
+    // Without crossfade the segments are simply appended
+    auto appended = processor->ConcatenateWithCrossfade({first, second}, 0);
+    EXPECT_EQ(appended.size(), first.size() + second.size());
+
+    // Segments shorter than the crossfade are handled gracefully
+    std::vector<float> tiny(10, 0.25f);
+    auto with_tiny = processor->ConcatenateWithCrossfade({first, tiny, second}, 10);
+    EXPECT_EQ(with_tiny.size(), first.size() + tiny.size() + second.size() - 10 - 240);
+
+    EXPECT_TRUE(processor->ConcatenateWithCrossfade({}, 10).empty());
+}
+
+TEST_F(AudioTest, InverseSTFTRoundTrip) {
+    // Kokoro's generator: n_fft 20, hop 5
+    const size_t n_fft = 20, hop = 5, bins = n_fft / 2 + 1;
+    const size_t length = 2400;
+    std::vector<float> signal(test_audio.begin(), test_audio.begin() + length);
+
+    // Centered forward STFT with a periodic Hann window (zero padding;
+    // the padded samples are dropped again by the inverse)
+    std::vector<double> padded(length + n_fft, 0.0);
+    std::copy(signal.begin(), signal.end(), padded.begin() + n_fft / 2);
+    const size_t frames = length / hop + 1;
+    std::vector<float> magnitude(bins * frames), phase(bins * frames);
+    for (size_t t = 0; t < frames; t++) {
+        for (size_t k = 0; k < bins; k++) {
+            double re = 0, im = 0;
+            for (size_t n = 0; n < n_fft; n++) {
+                double w = 0.5 - 0.5 * std::cos(2.0 * M_PI * n / n_fft);
+                double angle = -2.0 * M_PI * k * n / n_fft;
+                re += padded[t * hop + n] * w * std::cos(angle);
+                im += padded[t * hop + n] * w * std::sin(angle);
+            }
+            magnitude[k * frames + t] = static_cast<float>(std::hypot(re, im));
+            phase[k * frames + t] = static_cast<float>(std::atan2(im, re));
+        }
+    }
+
+    InverseSTFT istft(n_fft, hop);
+    auto restored = istft.Transform(magnitude.data(), phase.data(), frames);
+    ASSERT_EQ(restored.size(), hop * (frames - 1));
+    for (size_t i = 0; i < length; i++) {
+        ASSERT_NEAR(restored[i], signal[i], 1e-4f) << "at sample " << i;
+    }
+
+    // Pushing frames in uneven pieces gives the same samples as they finish
+    std::vector<float> streamed;
+    for (size_t t = 0; t < frames; t += 7) {
+        size_t count = std::min<size_t>(7, frames - t);
+        size_t before = streamed.size();
+        istft.Push(&magnitude[t], &phase[t], count, frames, streamed);
+        if (t + count < frames) {
+            EXPECT_GT(streamed.size(), before);
+        }
+    }
+    istft.Finish(streamed);
+    ASSERT_EQ(streamed.size(), restored.size());
+    for (size_t i = 0; i < streamed.size(); i++) {
+        ASSERT_NEAR(streamed[i], restored[i], 1e-6f) << "at sample " << i;
+    }
+
+    EXPECT_TRUE(istft.Transform(magnitude.data(), phase.data(), 0).empty());
+}
+
 TEST_F(AudioTest, EdgeCases) {
     // Test empty audio
     std::vector<float> empty;
@@ -291,6 +369,25 @@ TEST_F(AudioTest, WavConversion) {
     EXPECT_NE(wav_bytes.size(), wav_float.size());  // Should be different sizes
 }
 
+TEST_F(AudioTest, SharedSampleBuffer) {
+    AudioData original;
+    original.samples = test_audio;
+    ASSERT_EQ(original.samples.size(), test_audio.size());
+
+    // Copies share one allocation instead of duplicating the samples
+    AudioData copy = original;
+    EXPECT_EQ(copy.samples.data(), original.samples.data());
+    EXPECT_EQ(original.samples.use_count(), 2);
+
+    // Read-only vector APIs accept the shared buffer directly
+    auto processed = processor->ApplyVolume(copy.samples, 1.0f);
+    EXPECT_EQ(processed.size(), test_audio.size());
+
+    AudioData empty;
+    EXPECT_TRUE(empty.samples.empty());
+    EXPECT_EQ(empty.samples.begin(), empty.samples.end());
+}
+
 TEST_F(AudioTest, ErrorHandling) {
     // Test invalid parameters
     auto invalid_volume = processor->ApplyVolume(test_audio, -1.0f);
@@ -0,0 +1,256 @@
+#include <gtest/gtest.h>
+#include "jp_edge_tts/core/request_scheduler.h"
+#include "jp_edge_tts/core/session_manager.h"
+#include "jp_edge_tts/core/thread_tuner.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace jp_edge_tts;
+
+class SchedulerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // Single worker so execution order is fully determined by priority
+        scheduler = std::make_unique<RequestScheduler>(1);
+    }
+
+    void TearDown() override {
+        OpenGate();
+        scheduler.reset();
+    }
+
+    // Occupy the only worker until OpenGate() is called
+    void BlockWorker() {
+        std::promise<void> started;
+        auto started_future = started.get_future();
+        scheduler->Submit("gate", Priority::CRITICAL, [this, &started]() {
+            started.set_value();
+            std::unique_lock<std::mutex> lock(gate_mutex);
+            gate_cv.wait(lock, [this] { return gate_open; });
+        });
+        started_future.wait();
+    }
+
+    void OpenGate() {
+        {
+            std::lock_guard<std::mutex> lock(gate_mutex);
+            gate_open = true;
+        }
+        gate_cv.notify_all();
+    }
+
+    std::unique_ptr<RequestScheduler> scheduler;
+    std::mutex gate_mutex;
+    std::condition_variable gate_cv;
+    bool gate_open = false;
+};
+
+TEST_F(SchedulerTest, RunsHighestPriorityFirst) {
+    BlockWorker();
+
+    std::mutex order_mutex;
+    std::vector<std::string> order;
+    std::promise<void> all_done;
+    std::atomic<int> remaining{4};
+
+    auto record = [&](const std::string& id) {
+        return [&, id]() {
+            {
+                std::lock_guard<std::mutex> lock(order_mutex);
+                order.push_back(id);
+            }
+            if (--remaining == 0) all_done.set_value();
+        };
+    };
+
+    scheduler->Submit("low", Priority::LOW, record("low"));
+    scheduler->Submit("normal", Priority::NORMAL, record("normal"));
+    scheduler->Submit("critical", Priority::CRITICAL, record("critical"));
+    scheduler->Submit("high", Priority::HIGH, record("high"));
+    EXPECT_EQ(scheduler->GetQueueSize(), 4);
+
+    OpenGate();
+    ASSERT_EQ(all_done.get_future().wait_for(std::chrono::seconds(5)), std::future_status::ready);
+
+    std::vector<std::string> expected = {"critical", "high", "normal", "low"};
+    EXPECT_EQ(order, expected);
+}
+
+TEST_F(SchedulerTest, ReportsQueuePosition) {
+    BlockWorker();
+
+    EXPECT_EQ(*scheduler->Submit("a", Priority::LOW, [] {}), 0);
+    EXPECT_EQ(*scheduler->Submit("b", Priority::LOW, [] {}), 1);
+
+    // Higher priority jumps ahead of all queued LOW work
+    EXPECT_EQ(*scheduler->Submit("c", Priority::HIGH, [] {}), 0);
+    EXPECT_EQ(*scheduler->Submit("d", Priority::NORMAL, [] {}), 1);
+    EXPECT_EQ(scheduler->GetQueueSize(Priority::LOW), 2);
+}
+
+TEST_F(SchedulerTest, PositionIsSetBeforeRun) {
+    // With an idle worker the request may start before Submit returns
+    size_t position = 99;
+    std::promise<size_t> seen;
+    scheduler->Submit("first", Priority::NORMAL,
+                      [&position, &seen] { seen.set_value(position); },
+                      nullptr, &position);
+
+    auto seen_future = seen.get_future();
+    ASSERT_EQ(seen_future.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_EQ(seen_future.get(), 0u);
+}
+
+TEST_F(SchedulerTest, CancelsQueuedRequests) {
+    BlockWorker();
+
+    bool ran = false;
+    bool cancelled = false;
+    scheduler->Submit("victim", Priority::NORMAL,
+                      [&ran] { ran = true; },
+                      [&cancelled] { cancelled = true; });
+
+    EXPECT_TRUE(scheduler->IsPending("victim"));
+    EXPECT_TRUE(scheduler->Cancel("victim"));
+    EXPECT_TRUE(cancelled);
+    EXPECT_FALSE(scheduler->IsPending("victim"));
+    EXPECT_EQ(scheduler->GetQueueSize(), 0);
+
+    // Running and unknown requests cannot be cancelled
+    EXPECT_FALSE(scheduler->Cancel("gate"));
+    EXPECT_FALSE(scheduler->Cancel("missing"));
+
+    OpenGate();
+    scheduler->Shutdown();
+    EXPECT_FALSE(ran);
+}
+
+TEST(SchedulerLimitTest, RejectsWhenQueueFull) {
+    RequestScheduler limited(1, 2);
+
+    std::promise<void> release;
+    std::shared_future<void> gate = release.get_future().share();
+    std::promise<void> started;
+    limited.Submit("busy", Priority::NORMAL, [gate, &started] {
+        started.set_value();
+        gate.wait();
+    });
+    started.get_future().wait();
+
+    EXPECT_TRUE(limited.Submit("q1", Priority::LOW, [] {}).has_value());
+    EXPECT_TRUE(limited.Submit("q2", Priority::LOW, [] {}).has_value());
+    EXPECT_FALSE(limited.Submit("q3", Priority::CRITICAL, [] {}).has_value());
+    EXPECT_EQ(limited.GetQueueSize(), 2);
+
+    // Cancelling frees a slot
+    EXPECT_TRUE(limited.Cancel("q1"));
+    EXPECT_TRUE(limited.Submit("q3", Priority::CRITICAL, [] {}).has_value());
+
+    release.set_value();
+}
+
+TEST_F(SchedulerTest, ShutdownCancelsQueuedWork) {
+    BlockWorker();
+
+    std::atomic<int> cancelled{0};
+    for (int i = 0; i < 3; ++i) {
+        scheduler->Submit("job" + std::to_string(i), Priority::LOW,
+                          [] {}, [&cancelled] { cancelled++; });
+    }
+
+    OpenGate();
+    scheduler->Shutdown();
+    EXPECT_LE(cancelled.load(), 3);
+    EXPECT_EQ(scheduler->GetQueueSize(), 0);
+    EXPECT_THROW(scheduler->Submit("late", Priority::LOW, [] {}), std::runtime_error);
+}
+
+TEST(SessionPoolLayoutTest, SplitsCoresAcrossSessions) {
+    // Auto: one session per concurrent request, threads split evenly
+    auto layout = SessionManager::ResolvePoolLayout(0, 0, 4, 16);
+    EXPECT_EQ(layout.num_sessions, 4u);
+    EXPECT_EQ(layout.threads_per_session, 4);
+
+    // Never more sessions than half the cores
+    layout = SessionManager::ResolvePoolLayout(0, 0, 8, 4);
+    EXPECT_EQ(layout.num_sessions, 2u);
+    EXPECT_EQ(layout.threads_per_session, 2);
+
+    // Explicit settings win; a single core still gets one thread
+    layout = SessionManager::ResolvePoolLayout(3, 0, 1, 1);
+    EXPECT_EQ(layout.num_sessions, 3u);
+    EXPECT_EQ(layout.threads_per_session, 1);
+
+    layout = SessionManager::ResolvePoolLayout(2, 6, 4, 16);
+    EXPECT_EQ(layout.num_sessions, 2u);
+    EXPECT_EQ(layout.threads_per_session, 6);
+}
+
+TEST(ThreadTunerTest, CandidatesCoverPoolWidths) {
+    auto candidates = ThreadTuner::Candidates(8);
+    bool single = false, widest = false, parallel = false;
+    for (const auto& candidate : candidates) {
+        EXPECT_LE(candidate.session_pool_size * candidate.intra_threads, 8u);
+        single |= candidate.session_pool_size == 1 && candidate.intra_threads == 8;
+        widest |= candidate.session_pool_size == 8 && candidate.intra_threads == 1;
+        parallel |= candidate.inter_threads > 0;
+    }
+    EXPECT_TRUE(single);
+    EXPECT_TRUE(widest);
+    EXPECT_TRUE(parallel);
+
+    // A single core only has the one layout, with and without spinning
+    EXPECT_EQ(ThreadTuner::Candidates(1).size(), 2u);
+}
+
+TEST(ThreadTunerTest, SelectsFastestWithinLatencyTarget) {
+    std::vector<ThreadProfile> measured(3);
+    measured[0].throughput = 10;  measured[0].p95_ms = 40;
+    measured[1].throughput = 25;  measured[1].p95_ms = 120;
+    measured[2].throughput = 18;  measured[2].p95_ms = 60;
+
+    EXPECT_EQ(ThreadTuner::SelectBest(measured, 0), 1);
+    EXPECT_EQ(ThreadTuner::SelectBest(measured, 80), 2);
+
+    // Nothing meets the target: lowest latency wins
+    EXPECT_EQ(ThreadTuner::SelectBest(measured, 20), 0);
+    EXPECT_EQ(ThreadTuner::SelectBest({}, 0), -1);
+}
+
+TEST(ThreadTunerTest, ProfileRoundTrip) {
+    ThreadProfile profile;
+    profile.session_pool_size = 4;
+    profile.intra_threads = 2;
+    profile.inter_threads = 0;
+    profile.allow_spinning = false;
+    profile.throughput = 31.5;
+    profile.host = ThreadTuner::HostName();
+    profile.cores = 8;
+    profile.model_path = "models/kokoro.onnx";
+    profile.model_size = 12345;
+
+    std::string path = testing::TempDir() + "thread_profile_test.json";
+    ASSERT_TRUE(ThreadTuner::SaveProfile(path, profile));
+
+    ThreadProfile loaded;
+    ASSERT_TRUE(ThreadTuner::LoadProfile(path, loaded));
+    EXPECT_EQ(loaded.session_pool_size, 4u);
+    EXPECT_EQ(loaded.intra_threads, 2);
+    EXPECT_FALSE(loaded.allow_spinning);
+    EXPECT_DOUBLE_EQ(loaded.throughput, 31.5);
+    EXPECT_EQ(loaded.host, profile.host);
+    EXPECT_EQ(loaded.model_size, 12345);
+
+    // Measured against a model that is not there: never reused
+    EXPECT_FALSE(ThreadTuner::Matches(loaded, loaded.model_path));
+    std::remove(path.c_str());
+
+    EXPECT_FALSE(ThreadTuner::LoadProfile(path, loaded));
+}
@@ -263,4 +263,43 @@ TEST_F(TokenizerTest, UnknownPhonemeHandling) {
     // Convert back - unknown should become <unk>
     std::string recovered = tokenizer->TokensToPhonemes(tokens);
     EXPECT_EQ(recovered, "a <unk> k");
-}
\ No newline at end of file
+}
+
+TEST_F(TokenizerTest, ProsodicChunking) {
+    ASSERT_TRUE(tokenizer->LoadVocabularyFromJSON(R"({
+        "<pad>": 0, "<unk>": 1, ",": 3, ".": 4, "!": 5, " ": 16, "a": 43, "k": 53
+    })"));
+
+    // Within budget: a single chunk
+    std::vector<int> short_seq = {53, 43, 4};
+    auto single = tokenizer->ChunkTokens(short_seq, 10);
+    ASSERT_EQ(single.size(), 1);
+    EXPECT_EQ(single[0], short_seq);
+
+    // Sentence end in the second half of the budget is preferred
+    std::vector<int> sentences = {53, 43, 3, 53, 43, 53, 43, 4, 53, 43, 53, 43};
+    auto by_sentence = tokenizer->ChunkTokens(sentences, 10);
+    ASSERT_EQ(by_sentence.size(), 2);
+    EXPECT_EQ(by_sentence[0].back(), 4);
+    EXPECT_EQ(by_sentence[0].size(), 8);
+
+    // Falls back to clause punctuation, then spaces, then a hard cut
+    std::vector<int> clauses = {53, 43, 53, 43, 3, 53, 43, 53, 43, 53, 43, 53};
+    auto by_clause = tokenizer->ChunkTokens(clauses, 8);
+    ASSERT_GE(by_clause.size(), 2);
+    EXPECT_EQ(by_clause[0].back(), 3);
+
+    std::vector<int> no_boundary(25, 43);
+    auto hard = tokenizer->ChunkTokens(no_boundary, 10);
+    ASSERT_EQ(hard.size(), 3);
+    EXPECT_EQ(hard[0].size(), 10);
+    EXPECT_EQ(hard[2].size(), 5);
+
+    // Chunks always cover the input exactly, in order
+    std::vector<int> rejoined;
+    for (const auto& chunk : by_clause) {
+        EXPECT_LE(chunk.size(), 8);
+        rejoined.insert(rejoined.end(), chunk.begin(), chunk.end());
+    }
+    EXPECT_EQ(rejoined, clauses);
+}
@@ -0,0 +1,436 @@
+#include <gtest/gtest.h>
+#include "jp_edge_tts/utils/bounded_queue.h"
+#include "jp_edge_tts/utils/cancellation_token.h"
+#include "jp_edge_tts/utils/latency_histogram.h"
+#include "jp_edge_tts/utils/mapped_file.h"
+#include "jp_edge_tts/utils/single_flight.h"
+#include "jp_edge_tts/utils/token_file.h"
+#include "jp_edge_tts/utils/file_utils.h"
+#include "jp_edge_tts/utils/string_utils.h"
+#include "jp_edge_tts/types.h"
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace jp_edge_tts;
+
+TEST(LatencyHistogramTest, BucketLayout) {
+    // Small values get exact buckets
+    for (uint64_t v = 0; v < LatencyHistogram::SUB_BUCKET_COUNT; ++v) {
+        EXPECT_EQ(LatencyHistogram::BucketIndex(v), v);
+    }
+
+    // Every value falls inside its bucket's bounds and buckets are contiguous
+    for (uint64_t v : {32ull, 33ull, 63ull, 64ull, 1000ull, 123456ull, 987654321ull}) {
+        size_t index = LatencyHistogram::BucketIndex(v);
+        EXPECT_LE(LatencyHistogram::BucketLowerBound(index), v);
+        EXPECT_GE(LatencyHistogram::BucketUpperBound(index), v);
+        EXPECT_EQ(LatencyHistogram::BucketUpperBound(index) + 1,
+                  LatencyHistogram::BucketLowerBound(index + 1));
+    }
+
+    // Huge values clamp to the last bucket
+    EXPECT_EQ(LatencyHistogram::BucketIndex(UINT64_MAX), LatencyHistogram::BUCKET_COUNT - 1);
+}
+
+TEST(LatencyHistogramTest, Percentiles) {
+    LatencyHistogram histogram;
+
+    for (uint64_t v = 1; v <= 10000; ++v) {
+        histogram.RecordMicros(v);
+    }
+
+    auto snapshot = histogram.GetSnapshot();
+    EXPECT_EQ(snapshot.count, 10000u);
+    EXPECT_EQ(snapshot.min_us, 1u);
+    EXPECT_EQ(snapshot.max_us, 10000u);
+    EXPECT_NEAR(snapshot.Mean(), 5000.5, 0.01);
+
+    // Within bucket precision (~3%)
+    EXPECT_NEAR(snapshot.Percentile(50), 5000, 5000 * 0.03);
+    EXPECT_NEAR(snapshot.Percentile(90), 9000, 9000 * 0.03);
+    EXPECT_NEAR(snapshot.Percentile(99), 9900, 9900 * 0.03);
+    EXPECT_NEAR(snapshot.Percentile(99.9), 9990, 9990 * 0.03);
+    EXPECT_EQ(snapshot.Percentile(100), 10000u);
+
+    histogram.Reset();
+    snapshot = histogram.GetSnapshot();
+    EXPECT_EQ(snapshot.count, 0u);
+    EXPECT_EQ(snapshot.Percentile(50), 0u);
+}
+
+TEST(LatencyHistogramTest, ConcurrentRecording) {
+    LatencyHistogram histogram;
+    const int num_threads = 8;
+    const int per_thread = 10000;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&histogram, t]() {
+            for (int i = 0; i < per_thread; ++i) {
+                histogram.Record(std::chrono::microseconds(100 * (t + 1)));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    auto snapshot = histogram.GetSnapshot();
+    EXPECT_EQ(snapshot.count, static_cast<uint64_t>(num_threads * per_thread));
+    EXPECT_EQ(snapshot.min_us, 100u);
+    EXPECT_EQ(snapshot.max_us, 800u);
+}
+
+TEST(CancellationTokenTest, CallbacksFireOnceAndStopAfterUnregister) {
+    CancellationToken token;
+    int fired = 0;
+
+    {
+        CancellationRegistration registration(&token, [&fired]() { fired++; });
+        EXPECT_FALSE(token.IsCancelled());
+        EXPECT_TRUE(token.Cancel());
+        EXPECT_FALSE(token.Cancel());
+    }
+    EXPECT_TRUE(token.IsCancelled());
+    EXPECT_EQ(fired, 1);
+
+    // Registering on a cancelled token fires immediately
+    CancellationRegistration late(&token, [&fired]() { fired++; });
+    EXPECT_EQ(fired, 2);
+
+    // A null token is a no-op
+    CancellationRegistration none(nullptr, [&fired]() { fired++; });
+    EXPECT_EQ(fired, 2);
+}
+
+TEST(TokenFileTest, RoundTrip) {
+    std::string path = FileUtils::JoinPath(FileUtils::GetTempDirectory(), "test_tokens.jptk");
+
+    std::vector<TokenRecord> records = {
+        {"1", {12, 45, 0, 177}},
+        {"empty", {}},
+        {"wide", {300, 65535}},
+    };
+    ASSERT_TRUE(TokenFile::Write(path, records, 178));
+
+    std::vector<TokenRecord> loaded;
+    uint32_t vocabulary_size = 0;
+    ASSERT_TRUE(TokenFile::Read(path, loaded, &vocabulary_size));
+    EXPECT_EQ(vocabulary_size, 178u);
+    ASSERT_EQ(loaded.size(), records.size());
+    for (size_t i = 0; i < records.size(); i++) {
+        EXPECT_EQ(loaded[i].id, records[i].id);
+        EXPECT_EQ(loaded[i].tokens, records[i].tokens);
+    }
+
+    // Tokens outside 16 bits are rejected
+    EXPECT_FALSE(TokenFile::Write(path, {{"bad", {70000}}}, 178));
+
+    // Truncated files are rejected
+    auto bytes = FileUtils::ReadBinaryFile(path);
+    bytes.resize(bytes.size() - 1);
+    ASSERT_TRUE(FileUtils::WriteBinaryFile(path, bytes));
+    EXPECT_FALSE(TokenFile::Read(path, loaded));
+
+    FileUtils::DeleteFile(path);
+}
+
+TEST(StringUtilsTest, SplitSentences) {
+    using Pieces = std::vector<std::string>;
+
+    // Sentence and clause marks both end a piece and stay attached to it
+    EXPECT_EQ(StringUtils::SplitSentences("今日は晴れ。明日は雨。"),
+              (Pieces{"今日は晴れ。", "明日は雨。"}));
+    EXPECT_EQ(StringUtils::SplitSentences("はい、そうです。"),
+              (Pieces{"はい、", "そうです。"}));
+
+    // Runs of terminators are kept together
+    EXPECT_EQ(StringUtils::SplitSentences("本当！？はい。"),
+              (Pieces{"本当！？", "はい。"}));
+
+    // Short clauses merge with the next one; sentence ends always split
+    EXPECT_EQ(StringUtils::SplitSentences("はい、そうですね、わかりました。", 5),
+              (Pieces{"はい、そうですね、", "わかりました。"}));
+    EXPECT_EQ(StringUtils::SplitSentences("はい。そう、です。", 5),
+              (Pieces{"はい。", "そう、です。"}));
+
+    // Trailing text without a terminator is its own piece
+    EXPECT_EQ(StringUtils::SplitSentences("こんにちは。さようなら"),
+              (Pieces{"こんにちは。", "さようなら"}));
+    EXPECT_TRUE(StringUtils::SplitSentences("").empty());
+}
+
+TEST(ResultDiagnosticsTest, CompactPhonemes) {
+    EXPECT_EQ(ResultDiagnostics::IndexPhonemes("  k o  ɲ ", nullptr), 3u);
+    EXPECT_EQ(ResultDiagnostics::IndexPhonemes("", nullptr), 0u);
+
+    ResultDiagnostics first;
+    first.SetPhonemes("k o ɲ");
+    ASSERT_EQ(first.PhonemeCount(), 3u);
+    EXPECT_EQ(first.Phoneme(2), "ɲ");
+
+    // Appending shifts offsets into the combined string
+    ResultDiagnostics second;
+    second.SetPhonemes("tɕ i");
+    second.token_ids = {7, 8};
+    first.Append(second);
+    EXPECT_EQ(first.phoneme_text, "k o ɲ tɕ i");
+    EXPECT_EQ(first.token_ids, (std::vector<int>{7, 8}));
+
+    auto expanded = first.ExpandPhonemes();
+    ASSERT_EQ(expanded.size(), 5u);
+    EXPECT_EQ(expanded[3].phoneme, "tɕ");
+    EXPECT_EQ(expanded[3].position, 3);
+    EXPECT_EQ(expanded[4].phoneme, "i");
+}
+
+TEST(MappedFileTest, MapsFileContents) {
+    std::string path = FileUtils::JoinPath(FileUtils::GetTempDirectory(), "test_mapped.bin");
+    std::vector<uint8_t> bytes(10000);
+    for (size_t i = 0; i < bytes.size(); i++) {
+        bytes[i] = static_cast<uint8_t>(i * 7);
+    }
+    ASSERT_TRUE(FileUtils::WriteBinaryFile(path, bytes));
+
+    MappedFile mapped;
+    ASSERT_TRUE(mapped.Open(path));
+    ASSERT_EQ(mapped.size(), bytes.size());
+    EXPECT_EQ(std::memcmp(mapped.data(), bytes.data(), bytes.size()), 0);
+
+    // Moving transfers the mapping
+    MappedFile moved = std::move(mapped);
+    EXPECT_FALSE(mapped.IsOpen());
+    EXPECT_TRUE(moved.IsOpen());
+    EXPECT_EQ(moved.path(), path);
+
+    moved.Close();
+    EXPECT_FALSE(moved.IsOpen());
+    EXPECT_FALSE(moved.Open(path + ".missing"));
+
+    FileUtils::DeleteFile(path);
+}
+
+TEST(BoundedQueueTest, PushBlocksWhileFull) {
+    BoundedQueue<int> queue(2);
+    ASSERT_TRUE(queue.Push(1));
+    ASSERT_TRUE(queue.Push(2));
+
+    std::atomic<bool> pushed{false};
+    std::thread producer([&]() {
+        EXPECT_TRUE(queue.Push(3));
+        pushed = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(pushed);
+    EXPECT_EQ(queue.Size(), 2u);
+
+    // Popping makes room for the blocked producer
+    EXPECT_EQ(queue.Pop(), 1);
+    producer.join();
+    EXPECT_TRUE(pushed);
+    EXPECT_EQ(queue.Pop(), 2);
+    EXPECT_EQ(queue.Pop(), 3);
+    EXPECT_EQ(queue.PeakSize(), 2u);
+}
+
+TEST(BoundedQueueTest, TryPushRejectsWhenFullOrClosed) {
+    BoundedQueue<int> queue(1);
+    EXPECT_TRUE(queue.TryPush(1));
+    EXPECT_FALSE(queue.TryPush(2));
+    EXPECT_EQ(queue.Size(), 1u);
+
+    EXPECT_EQ(queue.Pop(), 1);
+    queue.Close();
+    EXPECT_FALSE(queue.TryPush(3));
+    EXPECT_FALSE(queue.Push(3));
+}
+
+TEST(BoundedQueueTest, CloseDrainsThenWakesConsumers) {
+    BoundedQueue<int> queue(4);
+    ASSERT_TRUE(queue.Push(1));
+    ASSERT_TRUE(queue.Push(2));
+    queue.Close();
+    EXPECT_TRUE(queue.IsClosed());
+
+    // Items queued before Close() are still delivered
+    EXPECT_EQ(queue.Pop(), 1);
+    EXPECT_EQ(queue.Pop(), 2);
+    EXPECT_EQ(queue.Pop(), std::nullopt);
+
+    // A consumer blocked on an empty queue is released by Close()
+    BoundedQueue<int> empty(1);
+    std::thread consumer([&]() { EXPECT_EQ(empty.Pop(), std::nullopt); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    empty.Close();
+    consumer.join();
+
+    // So is a producer blocked on a full one
+    BoundedQueue<int> full(1);
+    ASSERT_TRUE(full.Push(1));
+    std::thread producer([&]() { EXPECT_FALSE(full.Push(2)); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    full.Close();
+    producer.join();
+    EXPECT_EQ(full.Size(), 1u);
+}
+
+namespace {
+
+// Spin until the expected number of callers attached to the in-flight call
+void WaitForAttached(const SingleFlight<std::string, int>& flight, size_t count) {
+    while (flight.GetAttachCount() < count) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+} // namespace
+
+TEST(SingleFlightTest, AttachedCallersShareTheLeadersResult) {
+    SingleFlight<std::string, int> flight;
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    std::atomic<int> runs{0};
+
+    auto compute = [&]() {
+        runs++;
+        released.wait();
+        return 42;
+    };
+
+    const int num_callers = 4;
+    std::vector<int> results(num_callers, 0);
+    std::vector<bool> attached(num_callers, false);
+    std::vector<std::thread> callers;
+
+    // The leader holds the key until released
+    callers.emplace_back([&]() {
+        bool was_attached = true;
+        results[0] = flight.Do("key", compute, &was_attached);
+        attached[0] = was_attached;
+    });
+    while (flight.GetInFlightCount() == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    for (int i = 1; i < num_callers; ++i) {
+        callers.emplace_back([&, i]() {
+            bool was_attached = false;
+            results[i] = flight.Do("key", compute, &was_attached);
+            attached[i] = was_attached;
+        });
+    }
+    WaitForAttached(flight, num_callers - 1);
+
+    // A different key does not wait on the first
+    EXPECT_EQ(flight.Do("other", []() { return 7; }), 7);
+
+    release.set_value();
+    for (auto& caller : callers) {
+        caller.join();
+    }
+
+    EXPECT_EQ(runs, 1);
+    EXPECT_FALSE(attached[0]);
+    for (int i = 0; i < num_callers; ++i) {
+        EXPECT_EQ(results[i], 42);
+        if (i > 0) EXPECT_TRUE(attached[i]);
+    }
+    EXPECT_EQ(flight.GetLeaderCount(), 2u);
+    EXPECT_EQ(flight.GetAttachCount(), static_cast<size_t>(num_callers - 1));
+}
+
+TEST(SingleFlightTest, ExceptionsReachEveryCaller) {
+    SingleFlight<std::string, int> flight;
+    std::promise<void> release;
+    auto released = release.get_future().share();
+
+    auto failing = [&]() -> int {
+        released.wait();
+        throw std::runtime_error("inference failed");
+    };
+
+    std::atomic<int> thrown{0};
+    auto call = [&]() {
+        try {
+            flight.Do("key", failing);
+        } catch (const std::runtime_error& e) {
+            EXPECT_STREQ(e.what(), "inference failed");
+            thrown++;
+        }
+    };
+
+    std::thread leader(call);
+    while (flight.GetInFlightCount() == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::thread follower(call);
+    WaitForAttached(flight, 1);
+
+    release.set_value();
+    leader.join();
+    follower.join();
+    EXPECT_EQ(thrown, 2);
+
+    // A failed call does not hold on to its key
+    EXPECT_EQ(flight.GetInFlightCount(), 0u);
+    EXPECT_EQ(flight.Do("key", []() { return 1; }), 1);
+}
+
+TEST(SingleFlightTest, KeyIsReleasedAfterCompletion) {
+    SingleFlight<std::string, int> flight;
+    int runs = 0;
+
+    // Sequential calls each run the computation
+    EXPECT_EQ(flight.Do("key", [&]() { return ++runs; }), 1);
+    EXPECT_EQ(flight.GetInFlightCount(), 0u);
+    EXPECT_EQ(flight.Do("key", [&]() { return ++runs; }), 2);
+    EXPECT_EQ(flight.GetLeaderCount(), 2u);
+    EXPECT_EQ(flight.GetAttachCount(), 0u);
+
+    flight.ResetStats();
+    EXPECT_EQ(flight.GetLeaderCount(), 0u);
+}
+
+TEST(SingleFlightTest, AttachedCallerStopsAtDeadlineOrStop) {
+    SingleFlight<std::string, int> flight;
+    std::promise<void> release;
+    auto released = release.get_future().share();
+
+    std::thread leader([&]() {
+        EXPECT_EQ(flight.Do("key", [&]() { released.wait(); return 5; }), 5);
+    });
+    while (flight.GetInFlightCount() == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    auto never = []() { return false; };
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(30);
+    bool attached = false;
+    EXPECT_EQ(flight.DoUntil("key", []() { return 0; }, deadline, never, &attached),
+              std::nullopt);
+    EXPECT_TRUE(attached);
+    EXPECT_GE(std::chrono::steady_clock::now(), deadline);
+
+    // Stop is honoured without a deadline
+    std::atomic<bool> stop{false};
+    std::optional<int> stopped_result = 0;
+    std::thread stopped([&]() {
+        stopped_result = flight.DoUntil("key", []() { return 0; },
+                                        std::chrono::steady_clock::time_point::max(),
+                                        [&]() { return stop.load(); });
+    });
+    WaitForAttached(flight, 2);
+    stop = true;
+    stopped.join();
+    EXPECT_EQ(stopped_result, std::nullopt);
+
+    // The leader still finishes and releases the key
+    release.set_value();
+    leader.join();
+    EXPECT_EQ(flight.GetInFlightCount(), 0u);
+}